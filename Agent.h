@@ -15,12 +15,12 @@ public:
 
     // Getters
     int getId() const;
-    std::string getFirstName() const;
-    std::string getLastName() const;
-    std::string getPhone() const;
-    std::string getEmail() const;
-    Date getStartDate() const;
-    Date getEndDate() const;
+    const std::string &getFirstName() const;
+    const std::string &getLastName() const;
+    const std::string &getPhone() const;
+    const std::string &getEmail() const;
+    const Date &getStartDate() const;
+    const Date &getEndDate() const;
 
     // Setters
     void setId(int id);
@@ -4,68 +4,450 @@
 #include <stdexcept>
 #include <sstream>
 #include <iostream>
+#include <utility>
+#include <charconv>
+#include <chrono>
+#include <future>
+#include <string_view>
+#include <cstdio>
+#include <filesystem>
+#include "FileUtil.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
 
-// Helper function to split CSV line
-static std::vector<std::string> splitCSV(const std::string &line) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(line);
-    std::string token;
-    while (std::getline(ss, token, ',')) {
-        tokens.push_back(token);
+// Splits a CSV line into `tokens`, which view into `line`; the vector is
+// reused across lines so parsing a row allocates nothing. A trailing
+// separator yields a final empty field (e.g. an agent's open end date).
+static void splitCSV(std::string_view line, std::vector<std::string_view> &tokens) {
+    tokens.clear();
+    std::size_t start = 0;
+    for(;;) {
+        std::size_t comma = line.find(',', start);
+        if(comma == std::string_view::npos) {
+            tokens.push_back(line.substr(start));
+            return;
+        }
+        tokens.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+}
+
+// Non-throwing field parsers for the CSV loaders; false unless the whole
+// token is a number.
+static bool parseField(std::string_view token, int &value) {
+    const char *last = token.data() + token.size();
+    auto result = std::from_chars(token.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+static bool parseField(std::string_view token, double &value) {
+    const char *last = token.data() + token.size();
+    auto result = std::from_chars(token.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+// Row parsers: tokens are already split and counted by the loader.
+static Result<Agent> parseAgentRow(const std::vector<std::string_view> &tokens) {
+    int id = 0;
+    if(!parseField(tokens[0], id))
+        return ErrorCode::MalformedRecord;
+    std::optional<Date> start = Date::tryParse(tokens[5]);
+    std::optional<Date> end = Date::tryParse(tokens[6]);
+    if(!start || !end)
+        return ErrorCode::InvalidDate;
+    if(!start->isEmpty() && !end->isEmpty() && *end < *start)
+        return ErrorCode::InvalidDateRange;
+    Agent a;
+    a.setId(id);
+    a.setFirstName(std::string(tokens[1]));
+    a.setLastName(std::string(tokens[2]));
+    a.setPhone(std::string(tokens[3]));
+    a.setEmail(std::string(tokens[4]));
+    a.setStartDate(*start);
+    a.setEndDate(*end);
+    return a;
+}
+
+static Result<Client> parseClientRow(const std::vector<std::string_view> &tokens) {
+    int id = 0, married = 0;
+    double budget = 0.0;
+    if(!parseField(tokens[0], id) || !parseField(tokens[5], married) || !parseField(tokens[6], budget))
+        return ErrorCode::MalformedRecord;
+    std::optional<BudgetType> budgetType = parseBudgetType(tokens[7]);
+    if(!budgetType)
+        return ErrorCode::InvalidData;
+    Client c;
+    c.setId(id);
+    c.setFirstName(std::string(tokens[1]));
+    c.setLastName(std::string(tokens[2]));
+    c.setPhone(std::string(tokens[3]));
+    c.setEmail(std::string(tokens[4]));
+    c.setIsMarried(married != 0);
+    c.setBudget(budget);
+    c.setBudgetType(*budgetType);
+    return c;
+}
+
+static Result<Property> parsePropertyRow(const std::vector<std::string_view> &tokens) {
+    int id = 0, bedrooms = 0, bathrooms = 0, available = 0;
+    double sizeSqm = 0.0, price = 0.0;
+    if(!parseField(tokens[0], id) || !parseField(tokens[1], sizeSqm) || !parseField(tokens[2], price) ||
+       !parseField(tokens[4], bedrooms) || !parseField(tokens[5], bathrooms) || !parseField(tokens[7], available))
+        return ErrorCode::MalformedRecord;
+    std::optional<PropertyType> propertyType = parsePropertyType(tokens[3]);
+    std::optional<ListingType> listingType = parseListingType(tokens[8]);
+    if(!propertyType || !listingType)
+        return ErrorCode::InvalidData;
+    Property p;
+    p.setId(id);
+    p.setSizeSqm(sizeSqm);
+    p.setPrice(price);
+    p.setPropertyType(*propertyType);
+    p.setBedrooms(bedrooms);
+    p.setBathrooms(bathrooms);
+    p.setPlaceId(PlaceDictionary::instance().intern(tokens[6]));
+    p.setAvailability(available != 0);
+    p.setListingType(*listingType);
+    return p;
+}
+
+static Result<Contract> parseContractRow(const std::vector<std::string_view> &tokens) {
+    int id = 0, propertyId = 0, clientId = 0, agentId = 0, active = 0;
+    double price = 0.0;
+    if(!parseField(tokens[0], id) || !parseField(tokens[1], propertyId) || !parseField(tokens[2], clientId) ||
+       !parseField(tokens[3], agentId) || !parseField(tokens[4], price) || !parseField(tokens[8], active))
+        return ErrorCode::MalformedRecord;
+    std::optional<Date> start = Date::tryParse(tokens[5]);
+    std::optional<Date> end = Date::tryParse(tokens[6]);
+    if(!start || !end)
+        return ErrorCode::InvalidDate;
+    std::optional<ContractType> contractType = parseContractType(tokens[7]);
+    if(!contractType)
+        return ErrorCode::InvalidData;
+    if(*contractType == ContractType::Rent && !start->isEmpty() && !end->isEmpty() && *end < *start)
+        return ErrorCode::InvalidDateRange;
+    Contract ct;
+    ct.setId(id);
+    ct.setPropertyId(propertyId);
+    ct.setClientId(clientId);
+    ct.setAgentId(agentId);
+    ct.setPrice(price);
+    ct.setStartDate(*start);
+    ct.setEndDate(*end);
+    ct.setContractType(*contractType);
+    ct.setIsActive(active != 0);
+    return ct;
+}
+
+// Expected tokens: id,agentId,propertyId,dateTime,durationMinutes[,notes]
+// Notes are last and may themselves contain commas.
+static Result<Inspection> parseInspectionRow(const std::vector<std::string_view> &tokens) {
+    int id = 0, agentId = 0, propertyId = 0, duration = 0;
+    if(!parseField(tokens[0], id) || !parseField(tokens[1], agentId) || !parseField(tokens[2], propertyId) ||
+       !parseField(tokens[4], duration))
+        return ErrorCode::MalformedRecord;
+    std::optional<std::int32_t> start = Inspection::parseDateTime(tokens[3]);
+    if(!start)
+        return ErrorCode::InvalidDate;
+    std::string notes;
+    for(std::size_t t = 5; t < tokens.size(); ++t) {
+        if(t > 5) notes += ',';
+        notes += tokens[t];
+    }
+    Inspection i;
+    i.setId(id);
+    i.setAgentId(agentId);
+    i.setPropertyId(propertyId);
+    i.setStartMinute(*start);
+    i.setDurationMinutes(duration);
+    i.setNotes(notes);
+    return i;
+}
+
+// CSV row writers shared by full saves and appends.
+static void writeAgentRow(std::ostream &out, const Agent &a) {
+    out << a.getId() << ","
+        << a.getFirstName() << ","
+        << a.getLastName() << ","
+        << a.getPhone() << ","
+        << a.getEmail() << ","
+        << a.getStartDate() << ","
+        << a.getEndDate() << "\n";
+}
+
+static void writeClientRow(std::ostream &out, const Client &c) {
+    out << c.getId() << ","
+        << c.getFirstName() << ","
+        << c.getLastName() << ","
+        << c.getPhone() << ","
+        << c.getEmail() << ","
+        << (c.getIsMarried() ? 1 : 0) << ","
+        << c.getBudget() << ","
+        << c.getBudgetType() << "\n";
+}
+
+static void writePropertyRow(std::ostream &out, const Property &p) {
+    out << p.getId() << ","
+        << p.getSizeSqm() << ","
+        << p.getPrice() << ","
+        << p.getPropertyType() << ","
+        << p.getBedrooms() << ","
+        << p.getBathrooms() << ","
+        << p.getPlace() << ","
+        << (p.getAvailability() ? 1 : 0) << ","
+        << p.getListingType() << "\n";
+}
+
+static void writeContractRow(std::ostream &out, const Contract &c) {
+    out << c.getId() << ","
+        << c.getPropertyId() << ","
+        << c.getClientId() << ","
+        << c.getAgentId() << ","
+        << c.getPrice() << ","
+        << c.getStartDate() << ","  
+        << c.getEndDate() << "," 
+        << c.getContractType() << ","
+        << (c.getIsActive() ? 1 : 0) << "\n";
+}
+
+static void writeInspectionRow(std::ostream &out, const Inspection &i) {
+    out << i.getId() << ","
+        << i.getAgentId() << ","
+        << i.getPropertyId() << ","
+        << i.getDateTime() << ","
+        << i.getDurationMinutes() << ","
+        << i.getNotes() << "\n";
+}
+
+// One CSV row without its line break, as stored in journal records.
+template <typename T>
+static std::string formatRow(void (*writeRow)(std::ostream &, const T &), const T &value) {
+    std::ostringstream out;
+    writeRow(out, value);
+    std::string row = out.str();
+    row.pop_back();
+    return row;
+}
+
+// Raises the exception the throwing add API reports for a tryAdd error.
+[[noreturn]] static void throwAddError(ErrorCode error, const std::string &entity, int id,
+                                       const std::string &email = std::string(),
+                                       const std::string &phone = std::string()) {
+    switch(error) {
+        case ErrorCode::DuplicateId:
+            throw ValidationException("Duplicate " + entity + " ID: " + std::to_string(id));
+        case ErrorCode::DuplicateEmail:
+            throw DuplicateValueException(entity + " email", email);
+        case ErrorCode::DuplicatePhone:
+            throw DuplicateValueException(entity + " phone", phone);
+        case ErrorCode::BookingConflict:
+            throw ValidationException("The property is already rented or sold over the " + entity + " period.");
+        default:
+            throw ValidationException("Invalid " + entity + " data.");
     }
-    return tokens;
 }
 
-CRMSystem::CRMSystem() : nextAgentId(1), nextClientId(1), nextPropertyId(1), nextContractId(1) {
+static const char *const kJournalPath = "journal.log";
+
+CRMSystem::CRMSystem(Journal::SyncPolicy journalPolicy)
+    : nextAgentId(1), nextClientId(1), nextPropertyId(1), nextContractId(1), nextInspectionId(1) {
     loadData();
+    // Replayed records may touch any table and are checked against others.
+    std::error_code error;
+    std::uintmax_t journalSize = std::filesystem::file_size(kJournalPath, error);
+    if(!error && journalSize > 0)
+        ensureLoaded(AllTables);
+    // Journal is still null here, so replayed mutations are not journaled again.
+    std::size_t replayed = Journal::replay(kJournalPath, [this](const Journal::Record &record) { replayRecord(record); });
+    if(replayed)
+        std::cerr << "Recovered " << replayed << " journaled changes" << std::endl;
+    journal = std::make_unique<Journal>(kJournalPath, journalPolicy);
 }
 
 CRMSystem::~CRMSystem() {
-    saveData();
+    if(prefetcher.joinable())
+        prefetcher.join();
+    // Nothing is lost if this fails: the journal still holds every change.
+    try {
+        flush();
+    } catch(const std::exception &e) {
+        std::cerr << "Error saving data: " << e.what() << std::endl;
+    }
+}
+
+// ------------------------
+// Journal
+// ------------------------
+// Applies one journaled mutation on top of the loaded CSV data. The CSV
+// files may already contain it (a crash between saving and checkpointing),
+// so adds and modifies of an existing id are upserts and removing a
+// missing id is a no-op.
+void CRMSystem::replayRecord(const Journal::Record &record) {
+    int id = 0;
+    if(record.op == Journal::Op::Remove) {
+        if(!Journal::decodeId(record.payload, id)) {
+            std::cerr << "Error replaying journal record (" << toString(ErrorCode::MalformedRecord) << ")" << std::endl;
+            return;
+        }
+    }
+    std::vector<std::string_view> tokens;
+    splitCSV(record.payload, tokens);
+    ErrorCode error = ErrorCode::None;
+    try {
+        switch(record.table) {
+            case Journal::Table::Agents:
+                if(record.op == Journal::Op::Remove) { removeAgent(id); break; }
+                if(tokens.size() < 7) { error = ErrorCode::MalformedRecord; break; }
+                if(Result<Agent> row = parseAgentRow(tokens)) {
+                    if(!modifyAgent(std::move(*row))) error = tryAddAgent(std::move(*row)).error();
+                } else error = row.error();
+                break;
+            case Journal::Table::Clients:
+                if(record.op == Journal::Op::Remove) { removeClient(id); break; }
+                if(tokens.size() < 8) { error = ErrorCode::MalformedRecord; break; }
+                if(Result<Client> row = parseClientRow(tokens)) {
+                    if(!modifyClient(std::move(*row))) error = tryAddClient(std::move(*row)).error();
+                } else error = row.error();
+                break;
+            case Journal::Table::Properties:
+                if(record.op == Journal::Op::Remove) { removeProperty(id); break; }
+                if(tokens.size() < 9) { error = ErrorCode::MalformedRecord; break; }
+                if(Result<Property> row = parsePropertyRow(tokens)) {
+                    if(!modifyProperty(std::move(*row))) error = tryAddProperty(std::move(*row)).error();
+                } else error = row.error();
+                break;
+            case Journal::Table::Contracts:
+                if(record.op == Journal::Op::Remove) { removeContract(id); break; }
+                if(tokens.size() < 9) { error = ErrorCode::MalformedRecord; break; }
+                if(Result<Contract> row = parseContractRow(tokens)) {
+                    if(!modifyContract(std::move(*row))) error = tryAddContract(std::move(*row)).error();
+                } else error = row.error();
+                break;
+            case Journal::Table::Inspections:
+                if(record.op == Journal::Op::Remove) { cancelInspection(id); break; }
+                if(tokens.size() < 5) { error = ErrorCode::MalformedRecord; break; }
+                if(Result<Inspection> row = parseInspectionRow(tokens)) {
+                    if(!modifyInspection(*row)) error = tryScheduleInspection(std::move(*row)).error();
+                } else error = row.error();
+                break;
+            default:
+                error = ErrorCode::MalformedRecord;
+        }
+    } catch(const CRMException &e) {
+        std::cerr << "Error replaying journal record: " << e.what() << std::endl;
+        return;
+    }
+    if(error != ErrorCode::None)
+        std::cerr << "Error replaying journal record (" << toString(error) << "): " << record.payload << std::endl;
 }
 
 // ------------------------
 // Agent CRUD
 // ------------------------
 void CRMSystem::addAgent(const Agent &agent) {
-    Agent a = agent;
-    if (a.getId() == -1) {
-        a.setId(nextAgentId++);
+    addAgent(Agent(agent));
+}
+
+void CRMSystem::addAgent(Agent &&agent) {
+    Result<int> added = tryAddAgent(std::move(agent));
+    if(!added)
+        throwAddError(added.error(), "agent", agent.getId(), agent.getEmail(), agent.getPhone());
+}
+
+Result<int> CRMSystem::tryAddAgent(Agent &&agent) {
+    ensureLoaded(AgentsTable);
+    if (agent.getId() == -1) {
+        agent.setId(nextAgentId++);
     }
-    if (!a.isValid())
-        throw ValidationException("Invalid agent data.");
-    agents.push_back(a);
+    if (!agent.isValid())
+        return ErrorCode::InvalidData;
+    if(agentIndex.count(agent.getId()))
+        return ErrorCode::DuplicateId;
+    if(!agentEmails.isAvailable(agent.getEmail(), agent.getId()))
+        return ErrorCode::DuplicateEmail;
+    if(!agentPhones.isAvailable(agent.getPhone(), agent.getId()))
+        return ErrorCode::DuplicatePhone;
+    if(agent.getId() >= nextAgentId)
+        nextAgentId = agent.getId() + 1;
+    agentNames.insert(agent.getId(), agent.getFirstName(), agent.getLastName());
+    agentEmails.claim(agent.getEmail(), agent.getId());
+    agentPhones.claim(agent.getPhone(), agent.getId());
+    agentTenures.insert(agent.getId(), agent.getStartDate(), agent.getEndDate());
+    int id = agent.getId();
+    agentIndex.emplace(id, agents.insert(std::move(agent)));
+    agentChanges.appended.push_back(id);
+    if(journal) journal->append(Journal::Op::Add, Journal::Table::Agents, formatRow(writeAgentRow, *findAgent(id)));
+    return id;
 }
 
 bool CRMSystem::removeAgent(int agentId) {
-    auto it = std::remove_if(agents.begin(), agents.end(),
-                             [agentId](const Agent &a){ return a.getId() == agentId; });
-    if(it != agents.end()) {
-        agents.erase(it, agents.end());
-        return true;
-    }
-    return false;
+    ensureLoaded(AgentsTable | ContractsTable | InspectionsTable);
+    auto found = agentIndex.find(agentId);
+    if(found == agentIndex.end())
+        return false;
+    if(hasContractsForAgent(agentId))
+        throw ValidationException("Agent " + std::to_string(agentId) + " is referenced by existing contracts.");
+    if(agentCalendars.count(agentId))
+        throw ValidationException("Agent " + std::to_string(agentId) + " has scheduled inspections.");
+    const Agent &existing = *agents.get(found->second);
+    agentNames.erase(existing.getId(), existing.getFirstName(), existing.getLastName());
+    agentEmails.release(existing.getEmail(), existing.getId());
+    agentPhones.release(existing.getPhone(), existing.getId());
+    agentTenures.erase(existing.getId());
+    agents.erase(found->second);
+    agentIndex.erase(found);
+    agentChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Remove, Journal::Table::Agents, Journal::encodeId(agentId));
+    return true;
 }
 
 Agent CRMSystem::searchAgentById(int agentId) const {
-    for(const auto &a : agents) {
-        if(a.getId() == agentId)
-            return a;
-    }
+    return getAgentById(agentId);
+}
+
+const Agent* CRMSystem::findAgent(int agentId) const {
+    if(std::optional<const Agent*> served = lookupInSnapshot(Snapshot::Agents, agentId, snapshotAgents, &Snapshot::findAgent, &Snapshot::toAgent))
+        return *served;
+    ensureLoaded(AgentsTable);
+    auto found = agentIndex.find(agentId);
+    return found != agentIndex.end() ? agents.get(found->second) : nullptr;
+}
+
+const Agent& CRMSystem::getAgentById(int agentId) const {
+    if(const Agent *agent = findAgent(agentId))
+        return *agent;
     throw AgentNotFoundException(agentId);
 }
 
 bool CRMSystem::modifyAgent(const Agent &modifiedAgent) {
-    for(auto &a : agents) {
-        if(a.getId() == modifiedAgent.getId()) {
-            a = modifiedAgent;
-            return true;
-        }
-    }
-    return false;
+    return modifyAgent(Agent(modifiedAgent));
+}
+
+bool CRMSystem::modifyAgent(Agent &&modifiedAgent) {
+    ensureLoaded(AgentsTable);
+    auto found = agentIndex.find(modifiedAgent.getId());
+    if(found == agentIndex.end())
+        return false;
+    Agent &existing = *agents.get(found->second);
+    // Only a changed value is checked, so a duplicate loaded from disk can
+    // still be edited while it keeps its email or phone.
+    if(!agentEmails.canReplace(existing.getEmail(), modifiedAgent.getEmail(), existing.getId()))
+        throw DuplicateValueException("agent email", modifiedAgent.getEmail());
+    if(!agentPhones.canReplace(existing.getPhone(), modifiedAgent.getPhone(), existing.getId()))
+        throw DuplicateValueException("agent phone", modifiedAgent.getPhone());
+    agentNames.erase(existing.getId(), existing.getFirstName(), existing.getLastName());
+    agentEmails.replace(existing.getEmail(), modifiedAgent.getEmail(), existing.getId());
+    agentPhones.replace(existing.getPhone(), modifiedAgent.getPhone(), existing.getId());
+    existing = std::move(modifiedAgent);
+    agentNames.insert(existing.getId(), existing.getFirstName(), existing.getLastName());
+    agentTenures.insert(existing.getId(), existing.getStartDate(), existing.getEndDate());
+    agentChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Modify, Journal::Table::Agents, formatRow(writeAgentRow, existing));
+    return true;
 }
 
 void CRMSystem::displayAgents() const {
+    ensureLoaded(AgentsTable);
     if(agents.empty()) {
         std::cout << "No agents in the system.\n";
         return;
@@ -75,48 +457,119 @@ void CRMSystem::displayAgents() const {
     }
 }
 
+CRMSystem::AgentHandle CRMSystem::getAgentHandle(int agentId) const {
+    ensureLoaded(AgentsTable);
+    auto found = agentIndex.find(agentId);
+    return found != agentIndex.end() ? found->second : AgentHandle{};
+}
+
+const Agent* CRMSystem::getAgent(AgentHandle handle) const {
+    ensureLoaded(AgentsTable);
+    return agents.get(handle);
+}
+
 // ------------------------
 // Client CRUD
 // ------------------------
 void CRMSystem::addClient(const Client &client) {
-    Client c = client;
-    if(c.getId() == -1) {
-        c.setId(nextClientId++);
+    addClient(Client(client));
+}
+
+void CRMSystem::addClient(Client &&client) {
+    Result<int> added = tryAddClient(std::move(client));
+    if(!added)
+        throwAddError(added.error(), "client", client.getId(), client.getEmail(), client.getPhone());
+}
+
+Result<int> CRMSystem::tryAddClient(Client &&client) {
+    ensureLoaded(ClientsTable);
+    if(client.getId() == -1) {
+        client.setId(nextClientId++);
     }
-    if(!c.isValid())
-        throw ValidationException("Invalid client data.");
-    clients.push_back(c);
+    if(!client.isValid())
+        return ErrorCode::InvalidData;
+    if(clientIndex.count(client.getId()))
+        return ErrorCode::DuplicateId;
+    if(!clientEmails.isAvailable(client.getEmail(), client.getId()))
+        return ErrorCode::DuplicateEmail;
+    if(!clientPhones.isAvailable(client.getPhone(), client.getId()))
+        return ErrorCode::DuplicatePhone;
+    if(client.getId() >= nextClientId)
+        nextClientId = client.getId() + 1;
+    clientNames.insert(client.getId(), client.getFirstName(), client.getLastName());
+    clientEmails.claim(client.getEmail(), client.getId());
+    clientPhones.claim(client.getPhone(), client.getId());
+    int id = client.getId();
+    clientIndex.emplace(id, clients.insert(std::move(client)));
+    clientChanges.appended.push_back(id);
+    if(journal) journal->append(Journal::Op::Add, Journal::Table::Clients, formatRow(writeClientRow, *findClient(id)));
+    return id;
 }
 
 bool CRMSystem::removeClient(int clientId) {
-    auto it = std::remove_if(clients.begin(), clients.end(),
-                             [clientId](const Client &c){ return c.getId() == clientId; });
-    if(it != clients.end()) {
-        clients.erase(it, clients.end());
-        return true;
-    }
-    return false;
+    ensureLoaded(ClientsTable | ContractsTable);
+    auto found = clientIndex.find(clientId);
+    if(found == clientIndex.end())
+        return false;
+    if(hasContractsForClient(clientId))
+        throw ValidationException("Client " + std::to_string(clientId) + " is referenced by existing contracts.");
+    const Client &existing = *clients.get(found->second);
+    clientNames.erase(existing.getId(), existing.getFirstName(), existing.getLastName());
+    clientEmails.release(existing.getEmail(), existing.getId());
+    clientPhones.release(existing.getPhone(), existing.getId());
+    clients.erase(found->second);
+    clientIndex.erase(found);
+    clientChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Remove, Journal::Table::Clients, Journal::encodeId(clientId));
+    return true;
 }
 
 Client CRMSystem::searchClientById(int clientId) const {
-    for(const auto &c : clients) {
-        if(c.getId() == clientId)
-            return c;
-    }
+    return getClientById(clientId);
+}
+
+const Client* CRMSystem::findClient(int clientId) const {
+    if(std::optional<const Client*> served = lookupInSnapshot(Snapshot::Clients, clientId, snapshotClients, &Snapshot::findClient, &Snapshot::toClient))
+        return *served;
+    ensureLoaded(ClientsTable);
+    auto found = clientIndex.find(clientId);
+    return found != clientIndex.end() ? clients.get(found->second) : nullptr;
+}
+
+const Client& CRMSystem::getClientById(int clientId) const {
+    if(const Client *client = findClient(clientId))
+        return *client;
     throw ClientNotFoundException(clientId);
 }
 
 bool CRMSystem::modifyClient(const Client &modifiedClient) {
-    for(auto &c : clients) {
-        if(c.getId() == modifiedClient.getId()) {
-            c = modifiedClient;
-            return true;
-        }
-    }
-    return false;
+    return modifyClient(Client(modifiedClient));
+}
+
+bool CRMSystem::modifyClient(Client &&modifiedClient) {
+    ensureLoaded(ClientsTable);
+    auto found = clientIndex.find(modifiedClient.getId());
+    if(found == clientIndex.end())
+        return false;
+    Client &existing = *clients.get(found->second);
+    // Only a changed value is checked, so a duplicate loaded from disk can
+    // still be edited while it keeps its email or phone.
+    if(!clientEmails.canReplace(existing.getEmail(), modifiedClient.getEmail(), existing.getId()))
+        throw DuplicateValueException("client email", modifiedClient.getEmail());
+    if(!clientPhones.canReplace(existing.getPhone(), modifiedClient.getPhone(), existing.getId()))
+        throw DuplicateValueException("client phone", modifiedClient.getPhone());
+    clientNames.erase(existing.getId(), existing.getFirstName(), existing.getLastName());
+    clientEmails.replace(existing.getEmail(), modifiedClient.getEmail(), existing.getId());
+    clientPhones.replace(existing.getPhone(), modifiedClient.getPhone(), existing.getId());
+    existing = std::move(modifiedClient);
+    clientNames.insert(existing.getId(), existing.getFirstName(), existing.getLastName());
+    clientChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Modify, Journal::Table::Clients, formatRow(writeClientRow, existing));
+    return true;
 }
 
 void CRMSystem::displayClients() const {
+    ensureLoaded(ClientsTable);
     if(clients.empty()) {
         std::cout << "No clients in the system.\n";
         return;
@@ -126,48 +579,109 @@ void CRMSystem::displayClients() const {
     }
 }
 
+CRMSystem::ClientHandle CRMSystem::getClientHandle(int clientId) const {
+    ensureLoaded(ClientsTable);
+    auto found = clientIndex.find(clientId);
+    return found != clientIndex.end() ? found->second : ClientHandle{};
+}
+
+const Client* CRMSystem::getClient(ClientHandle handle) const {
+    ensureLoaded(ClientsTable);
+    return clients.get(handle);
+}
+
 // ------------------------
 // Property CRUD
 // ------------------------
 void CRMSystem::addProperty(const Property &property) {
-    Property p = property;
-    if(p.getId() == -1) {
-        p.setId(nextPropertyId++);
+    addProperty(Property(property));
+}
+
+void CRMSystem::addProperty(Property &&property) {
+    Result<int> added = tryAddProperty(std::move(property));
+    if(!added)
+        throwAddError(added.error(), "property", property.getId());
+}
+
+Result<int> CRMSystem::tryAddProperty(Property &&property) {
+    ensureLoaded(PropertiesTable);
+    if(property.getId() == -1) {
+        property.setId(nextPropertyId++);
     }
-    if(!p.isValid())
-        throw ValidationException("Invalid property data.");
-    properties.push_back(p);
+    if(!property.isValid())
+        return ErrorCode::InvalidData;
+    if(propertyIndex.count(property.getId()))
+        return ErrorCode::DuplicateId;
+    if(property.getId() >= nextPropertyId)
+        nextPropertyId = property.getId() + 1;
+    propertySearchIndex.insert(property);
+    if(propertyColumnsEnabled)
+        propertyColumns.insert(property);
+    int id = property.getId();
+    propertyIndex.emplace(id, properties.insert(std::move(property)));
+    propertyChanges.appended.push_back(id);
+    if(journal) journal->append(Journal::Op::Add, Journal::Table::Properties, formatRow(writePropertyRow, *findProperty(id)));
+    return id;
 }
 
 bool CRMSystem::removeProperty(int propertyId) {
-    auto it = std::remove_if(properties.begin(), properties.end(),
-                             [propertyId](const Property &p){ return p.getId() == propertyId; });
-    if(it != properties.end()) {
-        properties.erase(it, properties.end());
-        return true;
-    }
-    return false;
+    ensureLoaded(PropertiesTable | ContractsTable | InspectionsTable);
+    auto found = propertyIndex.find(propertyId);
+    if(found == propertyIndex.end())
+        return false;
+    if(contractsByProperty.count(propertyId))
+        throw ValidationException("Property " + std::to_string(propertyId) + " is referenced by existing contracts.");
+    if(propertyCalendars.count(propertyId))
+        throw ValidationException("Property " + std::to_string(propertyId) + " has scheduled inspections.");
+    properties.erase(found->second);
+    propertyIndex.erase(found);
+    propertySearchIndex.erase(propertyId);
+    if(propertyColumnsEnabled)
+        propertyColumns.erase(propertyId);
+    propertyChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Remove, Journal::Table::Properties, Journal::encodeId(propertyId));
+    return true;
 }
 
 Property CRMSystem::searchPropertyById(int propertyId) const {
-    for(const auto &p : properties) {
-        if(p.getId() == propertyId)
-            return p;
-    }
+    return getPropertyById(propertyId);
+}
+
+const Property* CRMSystem::findProperty(int propertyId) const {
+    if(std::optional<const Property*> served = lookupInSnapshot(Snapshot::Properties, propertyId, snapshotProperties, &Snapshot::findProperty, &Snapshot::toProperty))
+        return *served;
+    ensureLoaded(PropertiesTable);
+    auto found = propertyIndex.find(propertyId);
+    return found != propertyIndex.end() ? properties.get(found->second) : nullptr;
+}
+
+const Property& CRMSystem::getPropertyById(int propertyId) const {
+    if(const Property *property = findProperty(propertyId))
+        return *property;
     throw PropertyNotFoundException(propertyId);
 }
 
 bool CRMSystem::modifyProperty(const Property &modifiedProperty) {
-    for(auto &p : properties) {
-        if(p.getId() == modifiedProperty.getId()) {
-            p = modifiedProperty;
-            return true;
-        }
-    }
-    return false;
+    return modifyProperty(Property(modifiedProperty));
+}
+
+bool CRMSystem::modifyProperty(Property &&modifiedProperty) {
+    ensureLoaded(PropertiesTable);
+    auto found = propertyIndex.find(modifiedProperty.getId());
+    if(found == propertyIndex.end())
+        return false;
+    Property &existing = *properties.get(found->second);
+    existing = std::move(modifiedProperty);
+    propertySearchIndex.insert(existing);
+    if(propertyColumnsEnabled)
+        propertyColumns.insert(existing);
+    propertyChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Modify, Journal::Table::Properties, formatRow(writePropertyRow, existing));
+    return true;
 }
 
 void CRMSystem::displayProperties() const {
+    ensureLoaded(PropertiesTable);
     if(properties.empty()) {
         std::cout << "No properties in the system.\n";
         return;
@@ -177,48 +691,300 @@ void CRMSystem::displayProperties() const {
     }
 }
 
+CRMSystem::PropertyHandle CRMSystem::getPropertyHandle(int propertyId) const {
+    ensureLoaded(PropertiesTable);
+    auto found = propertyIndex.find(propertyId);
+    return found != propertyIndex.end() ? found->second : PropertyHandle{};
+}
+
+const Property* CRMSystem::getProperty(PropertyHandle handle) const {
+    ensureLoaded(PropertiesTable);
+    return properties.get(handle);
+}
+
+std::vector<const Property*> CRMSystem::findProperties(const PropertyFilter &filter) const {
+    ensureLoaded(PropertiesTable);
+    if(propertyColumnsEnabled && !filter.place)
+        return scanProperties(filter);
+
+    std::vector<const Property*> result;
+    auto keep = [&filter](const Property &p) {
+        return (!filter.available || p.getAvailability() == *filter.available) &&
+               (!filter.minBedrooms || p.getBedrooms() >= *filter.minBedrooms);
+    };
+    if(!filter.hasIndexedCriteria()) {
+        for(const auto &p : properties) {
+            if(keep(p)) result.push_back(&p);
+        }
+        return result;
+    }
+    std::vector<int> ids = propertySearchIndex.find(filter);
+    result.reserve(ids.size());
+    for(int id : ids) {
+        const Property *p = properties.get(propertyIndex.at(id));
+        if(keep(*p)) result.push_back(p);
+    }
+    return result;
+}
+
+void CRMSystem::setPropertyColumnsEnabled(bool enabled) {
+    ensureLoaded(PropertiesTable);
+    propertyColumns.clear();
+    propertyColumnsEnabled = enabled;
+    if(!enabled) return;
+    propertyColumns.reserve(properties.size());
+    for(const auto &p : properties) {
+        propertyColumns.insert(p);
+    }
+}
+
+bool CRMSystem::isPropertyColumnsEnabled() const {
+    return propertyColumnsEnabled;
+}
+
+std::vector<const Property*> CRMSystem::scanProperties(const PropertyFilter &filter) const {
+    ensureLoaded(PropertiesTable);
+    std::vector<const Property*> result;
+    if(!propertyColumnsEnabled) {
+        for(const auto &p : properties) {
+            if(filter.matches(p)) result.push_back(&p);
+        }
+        return result;
+    }
+    std::vector<int> ids = propertyColumns.selectIds(filter);
+    result.reserve(ids.size());
+    for(int id : ids) {
+        result.push_back(properties.get(propertyIndex.at(id)));
+    }
+    return result;
+}
+
+PropertyStats CRMSystem::propertyStats(const PropertyFilter &filter) const {
+    ensureLoaded(PropertiesTable);
+    if(propertyColumnsEnabled)
+        return propertyColumns.aggregate(filter);
+    PropertyStatsBuilder stats;
+    for(const auto &p : properties) {
+        if(filter.matches(p))
+            stats.add(p.getPrice(), p.getSizeSqm());
+    }
+    return stats.result();
+}
+
+std::vector<const Property*> CRMSystem::getPropertiesInPlace(const std::string &place) const {
+    ensureLoaded(PropertiesTable);
+    std::vector<const Property*> result;
+    std::optional<std::uint32_t> placeId = PlaceDictionary::instance().find(place);
+    const std::unordered_set<int> *ids = placeId ? propertySearchIndex.inPlace(*placeId) : nullptr;
+    if(!ids) return result;
+    result.reserve(ids->size());
+    for(int id : *ids) {
+        result.push_back(properties.get(propertyIndex.at(id)));
+    }
+    return result;
+}
+
+std::unordered_map<std::uint32_t, std::size_t> CRMSystem::countPropertiesByPlace() const {
+    ensureLoaded(PropertiesTable);
+    return propertySearchIndex.countByPlace();
+}
+
+std::unordered_map<std::uint32_t, PropertyStats> CRMSystem::propertyStatsByPlace(const PropertyFilter &filter) const {
+    ensureLoaded(PropertiesTable);
+    if(propertyColumnsEnabled)
+        return propertyColumns.aggregateByPlace(filter);
+    std::unordered_map<std::uint32_t, PropertyStatsBuilder> groups;
+    for(const auto &p : properties) {
+        if(filter.matches(p))
+            groups[p.getPlaceId()].add(p.getPrice(), p.getSizeSqm());
+    }
+    std::unordered_map<std::uint32_t, PropertyStats> result;
+    result.reserve(groups.size());
+    for(const auto &group : groups) {
+        result.emplace(group.first, group.second.result());
+    }
+    return result;
+}
+
+// ------------------------
+// Contact Lookups
+// ------------------------
+const Agent* CRMSystem::findAgentByEmail(const std::string &email) const {
+    ensureLoaded(AgentsTable);
+    return getAgent(getAgentHandle(agentEmails.find(email)));
+}
+
+const Agent* CRMSystem::findAgentByPhone(const std::string &phone) const {
+    ensureLoaded(AgentsTable);
+    return getAgent(getAgentHandle(agentPhones.find(phone)));
+}
+
+const Client* CRMSystem::findClientByEmail(const std::string &email) const {
+    ensureLoaded(ClientsTable);
+    return getClient(getClientHandle(clientEmails.find(email)));
+}
+
+const Client* CRMSystem::findClientByPhone(const std::string &phone) const {
+    ensureLoaded(ClientsTable);
+    return getClient(getClientHandle(clientPhones.find(phone)));
+}
+
+// ------------------------
+// Name autocomplete
+// ------------------------
+std::vector<const Agent*> CRMSystem::autocompleteAgents(const std::string &prefix, std::size_t limit) const {
+    ensureLoaded(AgentsTable);
+    std::vector<const Agent*> result;
+    for(int id : agentNames.complete(prefix, limit)) {
+        result.push_back(agents.get(agentIndex.at(id)));
+    }
+    return result;
+}
+
+std::vector<const Client*> CRMSystem::autocompleteClients(const std::string &prefix, std::size_t limit) const {
+    ensureLoaded(ClientsTable);
+    std::vector<const Client*> result;
+    for(int id : clientNames.complete(prefix, limit)) {
+        result.push_back(clients.get(clientIndex.at(id)));
+    }
+    return result;
+}
+
+// ------------------------
+// Matchmaking
+// ------------------------
+ThreadPool &CRMSystem::workers() const {
+    std::call_once(workerPoolStarted, [this]() { workerPool.reset(new ThreadPool()); });
+    return *workerPool;
+}
+
+static Matchmaker::Request matchRequestFor(const Client &c) {
+    return Matchmaker::Request{c.getId(),
+                               c.getBudgetTypeEnum() == BudgetType::Rent ? Matchmaker::Market::Rent : Matchmaker::Market::Sale,
+                               c.getBudget()};
+}
+
+Matchmaker CRMSystem::buildMatchmaker(const MatchOptions &options) const {
+    std::vector<Matchmaker::Listing> listings;
+    listings.reserve(properties.size());
+    for(const auto &p : properties) {
+        if(!p.getAvailability()) continue;
+        listings.push_back({p.getId(),
+                            p.getListingTypeEnum() == ListingType::Rent ? Matchmaker::Market::Rent : Matchmaker::Market::Sale,
+                            p.getPrice(), p.getSizeSqm()});
+    }
+    return Matchmaker(listings, options);
+}
+
+std::vector<ClientMatches> CRMSystem::matchClients(const MatchOptions &options) const {
+    ensureLoaded(ClientsTable | PropertiesTable);
+    std::vector<Matchmaker::Request> requests;
+    requests.reserve(clients.size());
+    for(const auto &c : clients) {
+        requests.push_back(matchRequestFor(c));
+    }
+    return buildMatchmaker(options).matchAll(requests, workers());
+}
+
+ClientMatches CRMSystem::matchClient(int clientId, const MatchOptions &options) const {
+    ensureLoaded(ClientsTable | PropertiesTable);
+    auto found = clientIndex.find(clientId);
+    if(found == clientIndex.end())
+        throw ClientNotFoundException(clientId);
+    return buildMatchmaker(options).match(matchRequestFor(*clients.get(found->second)));
+}
+
 // ------------------------
 // Contract CRUD
 // ------------------------
 void CRMSystem::addContract(const Contract &contract) {
-    Contract ct = contract;
-    if(ct.getId() == -1) {
-        ct.setId(nextContractId++);
+    addContract(Contract(contract));
+}
+
+void CRMSystem::addContract(Contract &&contract) {
+    Result<int> added = tryAddContract(std::move(contract));
+    if(!added)
+        throwAddError(added.error(), "contract", contract.getId());
+}
+
+Result<int> CRMSystem::tryAddContract(Contract &&contract) {
+    ensureLoaded(ContractsTable);
+    if(contract.getId() == -1) {
+        contract.setId(nextContractId++);
     }
-    if(!ct.isValid())
-        throw ValidationException("Invalid contract data.");
-    contracts.push_back(ct);
+    if(!contract.isValid())
+        return ErrorCode::InvalidData;
+    if(contractIndex.count(contract.getId()))
+        return ErrorCode::DuplicateId;
+    if(bookingConflict(contract) != -1)
+        return ErrorCode::BookingConflict;
+    if(contract.getId() >= nextContractId)
+        nextContractId = contract.getId() + 1;
+    linkContract(contract);
+    int id = contract.getId();
+    contractIndex.emplace(id, contracts.insert(std::move(contract)));
+    contractChanges.appended.push_back(id);
+    if(journal) journal->append(Journal::Op::Add, Journal::Table::Contracts, formatRow(writeContractRow, *findContract(id)));
+    return id;
 }
 
 bool CRMSystem::removeContract(int contractId) {
-    auto it = std::remove_if(contracts.begin(), contracts.end(),
-                             [contractId](const Contract &c){ return c.getId() == contractId; });
-    if(it != contracts.end()) {
-        contracts.erase(it, contracts.end());
-        return true;
-    }
-    return false;
+    ensureLoaded(ContractsTable);
+    auto found = contractIndex.find(contractId);
+    if(found == contractIndex.end())
+        return false;
+    unlinkContract(*contracts.get(found->second));
+    contracts.erase(found->second);
+    contractIndex.erase(found);
+    contractChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Remove, Journal::Table::Contracts, Journal::encodeId(contractId));
+    return true;
 }
 
 Contract CRMSystem::searchContractById(int contractId) const {
-    for(const auto &c : contracts) {
-        if(c.getId() == contractId)
-            return c;
-    }
+    return getContractById(contractId);
+}
+
+const Contract* CRMSystem::findContract(int contractId) const {
+    if(std::optional<const Contract*> served = lookupInSnapshot(Snapshot::Contracts, contractId, snapshotContracts, &Snapshot::findContract, &Snapshot::toContract))
+        return *served;
+    ensureLoaded(ContractsTable);
+    auto found = contractIndex.find(contractId);
+    return found != contractIndex.end() ? contracts.get(found->second) : nullptr;
+}
+
+const Contract& CRMSystem::getContractById(int contractId) const {
+    if(const Contract *contract = findContract(contractId))
+        return *contract;
     throw ContractNotFoundException(contractId);
 }
 
 bool CRMSystem::modifyContract(const Contract &modifiedContract) {
-    for(auto &c : contracts) {
-        if(c.getId() == modifiedContract.getId()) {
-            c = modifiedContract;
-            return true;
-        }
+    return modifyContract(Contract(modifiedContract));
+}
+
+bool CRMSystem::modifyContract(Contract &&modifiedContract) {
+    ensureLoaded(ContractsTable);
+    auto found = contractIndex.find(modifiedContract.getId());
+    if(found == contractIndex.end())
+        return false;
+    Contract &existing = *contracts.get(found->second);
+    unlinkContract(existing);
+    int conflict = bookingConflict(modifiedContract);
+    if(conflict != -1) {
+        linkContract(existing);
+        throw ValidationException("Contract " + std::to_string(existing.getId()) +
+                                  " would overlap contract " + std::to_string(conflict) + " on the same property.");
     }
-    return false;
+    existing = std::move(modifiedContract);
+    linkContract(existing);
+    contractChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Modify, Journal::Table::Contracts, formatRow(writeContractRow, existing));
+    return true;
 }
 
 void CRMSystem::displayContracts() const {
+    ensureLoaded(ContractsTable);
     if(contracts.empty()) {
         std::cout << "No contracts in the system.\n";
         return;
@@ -228,237 +994,1181 @@ void CRMSystem::displayContracts() const {
     }
 }
 
+CRMSystem::ContractHandle CRMSystem::getContractHandle(int contractId) const {
+    ensureLoaded(ContractsTable);
+    auto found = contractIndex.find(contractId);
+    return found != contractIndex.end() ? found->second : ContractHandle{};
+}
+
+const Contract* CRMSystem::getContract(ContractHandle handle) const {
+    ensureLoaded(ContractsTable);
+    return contracts.get(handle);
+}
+
+// ------------------------
+// Date-Range Queries
+// ------------------------
+std::vector<const Contract*> CRMSystem::contractsActiveOn(const Date &day) const {
+    ensureLoaded(ContractsTable);
+    return contractsWithIds(contractPeriods.containing(day));
+}
+
+std::vector<const Contract*> CRMSystem::contractsOverlapping(const Date &from, const Date &to) const {
+    ensureLoaded(ContractsTable);
+    return contractsWithIds(contractPeriods.overlapping(from, to));
+}
+
+std::vector<const Contract*> CRMSystem::contractsStartingBetween(const Date &from, const Date &to) const {
+    ensureLoaded(ContractsTable);
+    return contractsWithIds(contractPeriods.startingBetween(from, to));
+}
+
+std::vector<const Agent*> CRMSystem::agentsEmployedOn(const Date &day) const {
+    ensureLoaded(AgentsTable);
+    return agentsWithIds(agentTenures.containing(day));
+}
+
+std::vector<const Agent*> CRMSystem::agentsEmployedDuring(const Date &from, const Date &to) const {
+    ensureLoaded(AgentsTable);
+    return agentsWithIds(agentTenures.overlapping(from, to));
+}
+
+std::vector<const Contract*> CRMSystem::contractsWithIds(const std::vector<int> &ids) const {
+    std::vector<const Contract*> result;
+    result.reserve(ids.size());
+    for(int id : ids) {
+        result.push_back(contracts.get(contractIndex.at(id)));
+    }
+    return result;
+}
+
+std::vector<const Agent*> CRMSystem::agentsWithIds(const std::vector<int> &ids) const {
+    std::vector<const Agent*> result;
+    result.reserve(ids.size());
+    for(int id : ids) {
+        result.push_back(agents.get(agentIndex.at(id)));
+    }
+    return result;
+}
+
+// ------------------------
+// Contract lookups
+// ------------------------
+static void eraseLink(std::unordered_multimap<int, int> &index, int key, int contractId) {
+    auto range = index.equal_range(key);
+    for(auto it = range.first; it != range.second; ++it) {
+        if(it->second == contractId) {
+            index.erase(it);
+            return;
+        }
+    }
+}
+
+// A sale holds its property from the start date on; a rent until its end.
+static Date bookedUntil(const Contract &contract) {
+    return contract.getContractTypeEnum() == ContractType::Sale ? Date::emptyDate() : contract.getEndDate();
+}
+
+void CRMSystem::linkContract(const Contract &contract) {
+    contractsByProperty.emplace(contract.getPropertyId(), contract.getId());
+    contractsByClient.emplace(contract.getClientId(), contract.getId());
+    contractsByAgent.emplace(contract.getAgentId(), contract.getId());
+    contractPeriods.insert(contract.getId(), contract.getStartDate(), contract.getEndDate());
+    if(contract.getIsActive())
+        propertyTimelines[contract.getPropertyId()].book(contract.getId(), contract.getStartDate(), bookedUntil(contract));
+}
+
+void CRMSystem::unlinkContract(const Contract &contract) {
+    eraseLink(contractsByProperty, contract.getPropertyId(), contract.getId());
+    eraseLink(contractsByClient, contract.getClientId(), contract.getId());
+    eraseLink(contractsByAgent, contract.getAgentId(), contract.getId());
+    contractPeriods.erase(contract.getId());
+    auto timeline = propertyTimelines.find(contract.getPropertyId());
+    if(timeline != propertyTimelines.end()) {
+        timeline->second.release(contract.getId(), contract.getStartDate());
+        if(timeline->second.empty())
+            propertyTimelines.erase(timeline);
+    }
+}
+
+// Inactive contracts do not book, but they are still checked: a contract
+// cannot be recorded over a period the property is already booked for.
+int CRMSystem::bookingConflict(const Contract &contract) const {
+    auto timeline = propertyTimelines.find(contract.getPropertyId());
+    if(timeline == propertyTimelines.end())
+        return -1;
+    return timeline->second.conflictWith(contract.getStartDate(), bookedUntil(contract));
+}
+
+std::vector<DateRange> CRMSystem::freePeriods(int propertyId, const Date &from, const Date &to) const {
+    ensureLoaded(PropertiesTable | ContractsTable);
+    if(propertyIndex.find(propertyId) == propertyIndex.end())
+        throw PropertyNotFoundException(propertyId);
+    auto timeline = propertyTimelines.find(propertyId);
+    if(timeline != propertyTimelines.end())
+        return timeline->second.freePeriods(from, to);
+    if(from.isEmpty() || to.isEmpty() || to < from)
+        return {};
+    return {DateRange{from, to}};
+}
+
+std::vector<const Contract*> CRMSystem::contractsFor(const std::unordered_multimap<int, int> &index, int key) const {
+    std::vector<const Contract*> result;
+    auto range = index.equal_range(key);
+    for(auto it = range.first; it != range.second; ++it) {
+        result.push_back(contracts.get(contractIndex.at(it->second)));
+    }
+    return result;
+}
+
+std::vector<const Contract*> CRMSystem::getContractsForProperty(int propertyId) const {
+    ensureLoaded(ContractsTable);
+    return contractsFor(contractsByProperty, propertyId);
+}
+
+std::vector<const Contract*> CRMSystem::getContractsForClient(int clientId) const {
+    ensureLoaded(ContractsTable);
+    return contractsFor(contractsByClient, clientId);
+}
+
+std::vector<const Contract*> CRMSystem::getContractsForAgent(int agentId) const {
+    ensureLoaded(ContractsTable);
+    return contractsFor(contractsByAgent, agentId);
+}
+
+bool CRMSystem::isPropertyUnderActiveContract(int propertyId) const {
+    ensureLoaded(ContractsTable);
+    auto range = contractsByProperty.equal_range(propertyId);
+    for(auto it = range.first; it != range.second; ++it) {
+        if(contracts.get(contractIndex.at(it->second))->getIsActive())
+            return true;
+    }
+    return false;
+}
+
+bool CRMSystem::hasContractsForAgent(int agentId) const {
+    ensureLoaded(ContractsTable);
+    return contractsByAgent.count(agentId) != 0;
+}
+
+bool CRMSystem::hasContractsForClient(int clientId) const {
+    ensureLoaded(ContractsTable);
+    return contractsByClient.count(clientId) != 0;
+}
+
 // Create contract from existing records
 void CRMSystem::createContract(int /*ignored*/, int propertyId, int clientId, int agentId,
                                double price, const std::string &startDateStr,
                                const std::string &endDateStr, const std::string &contractType, bool isActive)
 {
+    Result<int> created = tryCreateContract(propertyId, clientId, agentId, price,
+                                            startDateStr, endDateStr, contractType, isActive);
+    switch(created.error()) {
+        case ErrorCode::None:
+            return;
+        case ErrorCode::AgentNotFound:
+            throw ValidationException("Agent not found: " + std::to_string(agentId));
+        case ErrorCode::ClientNotFound:
+            throw ValidationException("Client not found: " + std::to_string(clientId));
+        case ErrorCode::PropertyNotFound:
+            throw ValidationException("Property not found: " + std::to_string(propertyId));
+        case ErrorCode::BookingConflict:
+            throw ValidationException("Property " + std::to_string(propertyId) +
+                                      " is already rented or sold over the requested period.");
+        case ErrorCode::InvalidDate:
+            throw ValidationException("Invalid date format or value: " +
+                                      (Date::tryParse(startDateStr) ? endDateStr : startDateStr));
+        default:
+            throw ValidationException("Invalid contract data");
+    }
+}
+
+Result<int> CRMSystem::tryCreateContract(int propertyId, int clientId, int agentId,
+                                         double price, const std::string &startDate,
+                                         const std::string &endDate, const std::string &contractType, bool isActive)
+{
+    ensureLoaded(AgentsTable | ClientsTable | PropertiesTable | ContractsTable);
     // Validate references first
-    try {
-        searchAgentById(agentId);
-    } catch (const AgentNotFoundException& e) {
-        throw ValidationException("Agent not found: " + std::to_string(agentId));
+    if(agentIndex.find(agentId) == agentIndex.end())
+        return ErrorCode::AgentNotFound;
+    if(clientIndex.find(clientId) == clientIndex.end())
+        return ErrorCode::ClientNotFound;
+    if(propertyIndex.find(propertyId) == propertyIndex.end())
+        return ErrorCode::PropertyNotFound;
+
+    std::optional<Date> start = Date::tryParse(startDate);
+    std::optional<Date> end = Date::tryParse(endDate);
+    if(!start || !end)
+        return ErrorCode::InvalidDate;
+    std::optional<ContractType> type = parseContractType(contractType);
+    if(!type)
+        return ErrorCode::InvalidData;
+
+    Contract contract;
+    contract.setId(-1);
+    contract.setPropertyId(propertyId);
+    contract.setClientId(clientId);
+    contract.setAgentId(agentId);
+    contract.setPrice(price);
+    contract.setStartDate(*start);
+    contract.setEndDate(*end);
+    contract.setContractType(*type);
+    contract.setIsActive(isActive);
+    return tryAddContract(std::move(contract));
+}
+
+// ------------------------
+// Inspection Scheduling
+// ------------------------
+void CRMSystem::scheduleInspection(const Inspection &inspection) {
+    Inspection copy = inspection;
+    Result<int> scheduled = tryScheduleInspection(std::move(copy));
+    switch(scheduled.error()) {
+        case ErrorCode::None:
+            return;
+        case ErrorCode::AgentNotFound:
+            throw ValidationException("Agent not found: " + std::to_string(inspection.getAgentId()));
+        case ErrorCode::PropertyNotFound:
+            throw ValidationException("Property not found: " + std::to_string(inspection.getPropertyId()));
+        case ErrorCode::BookingConflict:
+            throw ValidationException("Agent or property already has an inspection at " + inspection.getDateTime());
+        default:
+            throwAddError(scheduled.error(), "inspection", copy.getId());
     }
-    
-    try {
-        searchClientById(clientId);
-    } catch (const ClientNotFoundException& e) {
-        throw ValidationException("Client not found: " + std::to_string(clientId));
+}
+
+Result<int> CRMSystem::tryScheduleInspection(Inspection &&inspection) {
+    ensureLoaded(AgentsTable | PropertiesTable | InspectionsTable);
+    if(inspection.getId() == -1) {
+        inspection.setId(nextInspectionId++);
     }
-    
-    try {
-        searchPropertyById(propertyId);
-    } catch (const PropertyNotFoundException& e) {
-        throw ValidationException("Property not found: " + std::to_string(propertyId));
+    if(!inspection.isValid())
+        return ErrorCode::InvalidData;
+    if(inspectionIndex.count(inspection.getId()))
+        return ErrorCode::DuplicateId;
+    if(agentIndex.find(inspection.getAgentId()) == agentIndex.end())
+        return ErrorCode::AgentNotFound;
+    if(propertyIndex.find(inspection.getPropertyId()) == propertyIndex.end())
+        return ErrorCode::PropertyNotFound;
+    if(inspectionConflict(inspection) != -1)
+        return ErrorCode::BookingConflict;
+    if(inspection.getId() >= nextInspectionId)
+        nextInspectionId = inspection.getId() + 1;
+    bookInspection(inspection);
+    int id = inspection.getId();
+    inspectionIndex.emplace(id, inspections.insert(std::move(inspection)));
+    inspectionChanges.appended.push_back(id);
+    if(journal) journal->append(Journal::Op::Add, Journal::Table::Inspections, formatRow(writeInspectionRow, *findInspection(id)));
+    return id;
+}
+
+bool CRMSystem::cancelInspection(int inspectionId) {
+    ensureLoaded(InspectionsTable);
+    auto found = inspectionIndex.find(inspectionId);
+    if(found == inspectionIndex.end())
+        return false;
+    releaseInspection(*inspections.get(found->second));
+    inspections.erase(found->second);
+    inspectionIndex.erase(found);
+    inspectionChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Remove, Journal::Table::Inspections, Journal::encodeId(inspectionId));
+    return true;
+}
+
+bool CRMSystem::modifyInspection(const Inspection &modifiedInspection) {
+    ensureLoaded(InspectionsTable | AgentsTable | PropertiesTable);
+    auto found = inspectionIndex.find(modifiedInspection.getId());
+    if(found == inspectionIndex.end())
+        return false;
+    if(!modifiedInspection.isValid())
+        throw ValidationException("Invalid inspection data.");
+    if(agentIndex.find(modifiedInspection.getAgentId()) == agentIndex.end())
+        throw ValidationException("Agent not found: " + std::to_string(modifiedInspection.getAgentId()));
+    if(propertyIndex.find(modifiedInspection.getPropertyId()) == propertyIndex.end())
+        throw ValidationException("Property not found: " + std::to_string(modifiedInspection.getPropertyId()));
+    Inspection &existing = *inspections.get(found->second);
+    releaseInspection(existing);
+    if(inspectionConflict(modifiedInspection) != -1) {
+        bookInspection(existing);
+        throw ValidationException("Agent or property already has an inspection at " + modifiedInspection.getDateTime());
     }
+    existing = modifiedInspection;
+    bookInspection(existing);
+    inspectionChanges.rewrite = true;
+    if(journal) journal->append(Journal::Op::Modify, Journal::Table::Inspections, formatRow(writeInspectionRow, existing));
+    return true;
+}
 
-    Date startDate;
-    Date endDate = Date::emptyDate();
-    
-    try {
-        startDate = Date(startDateStr);
-        if (!endDateStr.empty()) {
-            endDate = Date(endDateStr);
+const Inspection* CRMSystem::findInspection(int inspectionId) const {
+    if(std::optional<const Inspection*> served = lookupInSnapshot(Snapshot::Inspections, inspectionId, snapshotInspections, &Snapshot::findInspection, &Snapshot::toInspection))
+        return *served;
+    ensureLoaded(InspectionsTable);
+    auto found = inspectionIndex.find(inspectionId);
+    return found != inspectionIndex.end() ? inspections.get(found->second) : nullptr;
+}
+
+void CRMSystem::displayInspections() const {
+    ensureLoaded(InspectionsTable);
+    if(inspections.empty()) {
+        std::cout << "No inspections in the system.\n";
+        return;
+    }
+    for(const auto &i : inspections) {
+        std::cout << i << "\n";
+    }
+}
+
+std::vector<const Inspection*> CRMSystem::getInspectionsForAgent(int agentId) const {
+    ensureLoaded(InspectionsTable);
+    return calendarInspections(agentCalendars, agentId);
+}
+
+std::vector<const Inspection*> CRMSystem::getInspectionsForProperty(int propertyId) const {
+    ensureLoaded(InspectionsTable);
+    return calendarInspections(propertyCalendars, propertyId);
+}
+
+static int calendarConflict(const std::unordered_map<int, InspectionCalendar> &calendars, int key,
+                            std::int32_t start, std::int32_t end) {
+    auto calendar = calendars.find(key);
+    return calendar != calendars.end() ? calendar->second.conflictWith(start, end) : -1;
+}
+
+int CRMSystem::agentInspectionConflict(int agentId, std::int32_t start, std::int32_t end) const {
+    ensureLoaded(InspectionsTable);
+    return calendarConflict(agentCalendars, agentId, start, end);
+}
+
+std::vector<std::int32_t> CRMSystem::suggestInspectionSlots(int agentId, int propertyId, std::int32_t fromMinute,
+                                                            std::size_t count, const SlotOptions &options) const {
+    ensureLoaded(InspectionsTable);
+    std::vector<std::int32_t> result;
+    const int slot = options.slotMinutes;
+    if(slot <= 0 || options.dayStartMinute + slot > options.dayEndMinute)
+        return result;
+
+    static const InspectionCalendar noBookings;
+    auto agentCalendar = agentCalendars.find(agentId);
+    auto propertyCalendar = propertyCalendars.find(propertyId);
+    const InspectionCalendar &agentBusy = agentCalendar != agentCalendars.end() ? agentCalendar->second : noBookings;
+    const InspectionCalendar &propertyBusy =
+        propertyCalendar != propertyCalendars.end() ? propertyCalendar->second : noBookings;
+
+    constexpr std::int32_t minutesPerDay = 24 * 60;
+    auto dayOf = [](std::int32_t minute) {
+        return minute >= 0 ? minute / minutesPerDay : (minute - minutesPerDay + 1) / minutesPerDay;
+    };
+    // First grid slot starting at or after `minute`, skipping to the next
+    // office day once the current one has no room left.
+    auto nextSlot = [&](std::int32_t minute) {
+        std::int32_t day = dayOf(minute);
+        std::int32_t opening = day * minutesPerDay + options.dayStartMinute;
+        std::int32_t offset = minute - opening;
+        std::int32_t start = offset <= 0 ? opening : opening + (offset + slot - 1) / slot * slot;
+        if(start + slot > day * minutesPerDay + options.dayEndMinute)
+            start = opening + minutesPerDay;
+        return start;
+    };
+
+    const std::int32_t horizon = (dayOf(fromMinute) + options.horizonDays) * minutesPerDay;
+    std::int32_t start = nextSlot(fromMinute);
+    while(result.size() < count && start < horizon) {
+        std::int32_t end = start + slot;
+        std::int32_t busy = std::max(agentBusy.busyUntil(start, end), propertyBusy.busyUntil(start, end));
+        if(busy == start) {
+            result.push_back(start);
+            start = nextSlot(end);
+        } else {
+            start = nextSlot(busy);
         }
-    } catch (const InvalidDateException& e) {
-        throw ValidationException("Invalid date format: " + std::string(e.what()));
     }
+    return result;
+}
+
+// Also used while loading inspections, so it must not go through the
+// public (ensureLoaded) members.
+int CRMSystem::inspectionConflict(const Inspection &inspection) const {
+    int conflict = calendarConflict(agentCalendars, inspection.getAgentId(), inspection.getStartMinute(),
+                                    inspection.getEndMinute());
+    if(conflict != -1)
+        return conflict;
+    return calendarConflict(propertyCalendars, inspection.getPropertyId(), inspection.getStartMinute(),
+                            inspection.getEndMinute());
+}
+
+void CRMSystem::bookInspection(const Inspection &inspection) {
+    agentCalendars[inspection.getAgentId()].book(inspection.getId(), inspection.getStartMinute(),
+                                                 inspection.getEndMinute());
+    propertyCalendars[inspection.getPropertyId()].book(inspection.getId(), inspection.getStartMinute(),
+                                                       inspection.getEndMinute());
+}
+
+static void releaseFrom(std::unordered_map<int, InspectionCalendar> &calendars, int key, const Inspection &inspection) {
+    auto calendar = calendars.find(key);
+    if(calendar == calendars.end())
+        return;
+    calendar->second.release(inspection.getId(), inspection.getStartMinute());
+    if(calendar->second.empty())
+        calendars.erase(calendar);
+}
 
-    Contract contract(-1, propertyId, clientId, agentId, price, startDateStr, endDateStr, contractType, isActive);
-    if (!contract.isValid()) {
-        throw ValidationException("Invalid contract data");
+void CRMSystem::releaseInspection(const Inspection &inspection) {
+    releaseFrom(agentCalendars, inspection.getAgentId(), inspection);
+    releaseFrom(propertyCalendars, inspection.getPropertyId(), inspection);
+}
+
+std::vector<const Inspection*> CRMSystem::calendarInspections(
+    const std::unordered_map<int, InspectionCalendar> &calendars, int key) const {
+    std::vector<const Inspection*> result;
+    auto calendar = calendars.find(key);
+    if(calendar == calendars.end())
+        return result;
+    for(const auto &range : calendar->second) {
+        result.push_back(inspections.get(inspectionIndex.at(range.second.second)));
     }
-    addContract(contract);
+    return result;
 }
 
 // ------------------------
 // File Persistence
 // ------------------------
+static const char *const kAgentsFile = "agents_data.csv";
+static const char *const kClientsFile = "clients_data.csv";
+static const char *const kPropertiesFile = "properties_data.csv";
+static const char *const kContractsFile = "contracts_data.csv";
+static const char *const kInspectionsFile = "inspections_data.csv";
+
+// Binary image of all tables; see saveBinarySnapshot.
+static const char *const kSnapshotFile = "crm_data.snap";
+
+// Lists the files of a commit whose temp files are complete; once it
+// exists the commit has happened and only the renames remain.
+static const char *const kManifestFile = "snapshot.manifest";
+
+static std::string tempPath(const std::string &path) {
+    return path + ".tmp";
+}
+
+static void renameOrThrow(const std::string &from, const std::string &to) {
+    std::error_code error;
+    std::filesystem::rename(from, to, error);
+    if(error) {
+        throw FileOperationException(to, "rename");
+    }
+}
+
+// Finishes the renames of a commit interrupted by a crash, and drops temp
+// files of one that never got its manifest.
+static void recoverTables() {
+    std::error_code error;
+    std::ifstream manifest(kManifestFile);
+    if(manifest) {
+        std::string table;
+        while(std::getline(manifest, table)) {
+            if(!table.empty() && std::filesystem::exists(tempPath(table), error))
+                renameOrThrow(tempPath(table), table);
+        }
+        manifest.close();
+        syncDirectory(".");
+        std::filesystem::remove(kManifestFile, error);
+    }
+    for(const char *table : {kAgentsFile, kClientsFile, kPropertiesFile, kContractsFile, kInspectionsFile, kSnapshotFile})
+        std::filesystem::remove(tempPath(table), error);
+}
+
+// Atomically replaces every file in `tables` with its fsynced temp file.
+// The manifest is the commit point: a crash before it is renamed into place
+// keeps all the old files, a crash after it is rolled forward on startup.
+static void commitTables(const std::vector<const char *> &tables) {
+    if(tables.empty())
+        return;
+    const std::string manifestTemp = tempPath(kManifestFile);
+    std::FILE *manifest = std::fopen(manifestTemp.c_str(), "wb");
+    if(!manifest) {
+        throw FileOperationException(manifestTemp, "write");
+    }
+    bool written = true;
+    for(const char *table : tables)
+        written = written && std::fprintf(manifest, "%s\n", table) > 0;
+    written = syncFile(manifest) && written;
+    std::fclose(manifest);
+    if(!written) {
+        throw FileOperationException(manifestTemp, "write");
+    }
+    renameOrThrow(manifestTemp, kManifestFile);
+    syncDirectory(".");
+
+    for(const char *table : tables)
+        renameOrThrow(tempPath(table), table);
+    syncDirectory(".");
+    std::error_code error;
+    std::filesystem::remove(kManifestFile, error);
+}
+
+// A parsed CSV row and the line it came from, for error messages.
+template <typename T>
+struct ParsedRow {
+    Result<T> row;
+    std::string_view line;
+};
+
+template <typename T>
+using RowParser = Result<T> (*)(const std::vector<std::string_view> &tokens);
+
+// Files below this size are parsed on the calling thread; larger ones are
+// cut into newline-aligned chunks of at least this size for the pool.
+static constexpr std::size_t kParallelParseBytes = std::size_t(1) << 20;
+
+// Parses every line of `text` with at least `minFields` fields. Blank and
+// short lines are skipped silently, as they always were. A trailing '\r'
+// (files saved on Windows) is dropped.
+template <typename T>
+static void parseLines(std::string_view text, std::size_t minFields, RowParser<T> parseRow,
+                       std::vector<ParsedRow<T>> &rows) {
+    std::vector<std::string_view> tokens;
+    while(!text.empty()) {
+        std::size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        if(!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if(line.empty())
+            continue;
+        splitCSV(line, tokens);
+        if(tokens.size() < minFields)
+            continue;
+        rows.push_back(ParsedRow<T>{parseRow(tokens), line});
+    }
+}
+
+// Parses a mapped CSV file, on `pool` if one is given. The result holds
+// one vector per chunk, in file order, so merging them in sequence sees
+// the rows exactly as a line-by-line reader would.
+template <typename T>
+static std::vector<std::vector<ParsedRow<T>>> parseCSVFile(const MappedFile &file, std::size_t minFields,
+                                                          RowParser<T> parseRow, ThreadPool *pool) {
+    std::string_view text = file.view();
+    std::vector<std::string_view> chunks;
+    std::size_t chunkSize = pool ? std::max(kParallelParseBytes, text.size() / (pool->size() * 4)) : text.size();
+    while(!text.empty()) {
+        std::size_t end = text.size() <= chunkSize ? std::string_view::npos : text.find('\n', chunkSize);
+        end = end == std::string_view::npos ? text.size() : end + 1;
+        chunks.push_back(text.substr(0, end));
+        text.remove_prefix(end);
+    }
+
+    std::vector<std::vector<ParsedRow<T>>> parsed(chunks.size());
+    if(chunks.size() <= 1) {
+        if(!chunks.empty())
+            parseLines(chunks[0], minFields, parseRow, parsed[0]);
+        return parsed;
+    }
+    pool->parallelFor(chunks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t c = begin; c < end; ++c)
+            parseLines(chunks[c], minFields, parseRow, parsed[c]);
+    });
+    return parsed;
+}
+
+// Records of a binary snapshot as one chunk of already parsed rows.
+template <typename T, typename R>
+static std::vector<std::vector<ParsedRow<T>>> snapshotRows(const Snapshot &snapshot, const R *records,
+                                                          std::size_t count, T (Snapshot::*convert)(const R &) const) {
+    std::vector<std::vector<ParsedRow<T>>> chunks(1);
+    chunks[0].reserve(count);
+    for(std::size_t r = 0; r < count; ++r)
+        chunks[0].push_back(ParsedRow<T>{(snapshot.*convert)(records[r]), std::string_view()});
+    return chunks;
+}
+
+template <typename T>
+static std::size_t rowCount(const std::vector<std::vector<ParsedRow<T>>> &chunks) {
+    std::size_t count = 0;
+    for(const auto &chunk : chunks)
+        count += chunk.size();
+    return count;
+}
+
+// Size and modification time of a table file; zeros if it does not exist.
+static Snapshot::SourceStamp sourceStamp(const char *path) {
+    std::error_code error;
+    std::uintmax_t size = std::filesystem::file_size(path, error);
+    if(error)
+        return Snapshot::SourceStamp{0, 0};
+    auto modified = std::filesystem::last_write_time(path, error);
+    if(error)
+        return Snapshot::SourceStamp{0, 0};
+    return Snapshot::SourceStamp{size, static_cast<std::int64_t>(modified.time_since_epoch().count())};
+}
+
+// The binary snapshot, if there is one and the CSV files have not been
+// written since it was taken. Anything else means loading from CSV.
+static std::optional<Snapshot> currentSnapshot() {
+    std::error_code error;
+    if(!std::filesystem::exists(kSnapshotFile, error))
+        return std::nullopt;
+    try {
+        std::optional<Snapshot> snapshot(std::in_place, kSnapshotFile);
+        const char *tables[Snapshot::kTableCount] = {kAgentsFile, kClientsFile, kPropertiesFile, kContractsFile, kInspectionsFile};
+        for(int table = 0; table < Snapshot::kTableCount; ++table) {
+            Snapshot::SourceStamp stamp = sourceStamp(tables[table]);
+            const Snapshot::SourceStamp &taken = snapshot->source(static_cast<Snapshot::Table>(table));
+            if(stamp.size != taken.size || stamp.modified != taken.modified)
+                return std::nullopt;
+        }
+        return snapshot;
+    } catch(const FileOperationException &e) {
+        std::cerr << "Ignoring binary snapshot: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
 void CRMSystem::loadData() {
-    loadAgents();
-    loadClients();
-    loadProperties();
-    loadContracts();
+    recoverTables();
+    if(std::optional<Snapshot> snapshot = currentSnapshot())
+        startupSnapshot = std::make_unique<Snapshot>(std::move(*snapshot));
+    loadTimes.assign(Snapshot::kTableCount, TableLoadTime{});
 }
 
-void CRMSystem::saveData() {
-    saveAgents();
-    saveClients();
-    saveProperties();
-    saveContracts();
+// Loads the missing tables among `tables`, one on this thread and the rest
+// on threads of their own. Loaders only touch their own table, indexes and
+// next id, so they run concurrently; a large file's parse fans out further
+// on the worker pool. They are not pool tasks themselves because a pool
+// thread helping with another parse could then wait on its own once_flag.
+void CRMSystem::ensureLoaded(unsigned tables) const {
+    unsigned missing = tables & ~loadedTables.load(std::memory_order_acquire);
+    if(!missing)
+        return;
+    // Loading fills in the tables of a system that is logically unchanged.
+    CRMSystem *self = const_cast<CRMSystem *>(this);
+    std::vector<std::future<void>> others;
+    std::size_t first = Snapshot::kTableCount;
+    for(std::size_t t = 0; t < Snapshot::kTableCount; ++t) {
+        if(!(missing & (1u << t)))
+            continue;
+        if(first == Snapshot::kTableCount)
+            first = t;
+        else
+            others.push_back(std::async(std::launch::async, [self, t]() { self->loadTable(t); }));
+    }
+    self->loadTable(first);
+    for(auto &loaded : others)
+        loaded.get();
 }
 
-void CRMSystem::loadAgents() {
-    std::ifstream in("agents_data.csv");
-    int maxId = 0;
-    if(!in) return;
-    std::string line;
-    while(std::getline(in, line)) {
-        if(line.empty()) continue;
-        auto tokens = splitCSV(line);
-        // Expected 7 tokens: id,firstName,lastName,phone,email,startDate,endDate
-        if(tokens.size() < 7) continue;
-        Agent a;
+void CRMSystem::loadTable(std::size_t table) {
+    using Loader = void (CRMSystem::*)(const Snapshot *);
+    struct TableLoader {
+        const char *name;
+        Loader load;
+        std::size_t (*rows)(const CRMSystem &);
+    };
+    static const TableLoader loaders[Snapshot::kTableCount] = {
+        {"agents", &CRMSystem::loadAgents, [](const CRMSystem &s) { return s.agents.size(); }},
+        {"clients", &CRMSystem::loadClients, [](const CRMSystem &s) { return s.clients.size(); }},
+        {"properties", &CRMSystem::loadProperties, [](const CRMSystem &s) { return s.properties.size(); }},
+        {"contracts", &CRMSystem::loadContracts, [](const CRMSystem &s) { return s.contracts.size(); }},
+        {"inspections", &CRMSystem::loadInspections, [](const CRMSystem &s) { return s.inspections.size(); }}};
+
+    std::call_once(tableLoads[table], [this, table]() {
+        const TableLoader &loader = loaders[table];
+        auto start = std::chrono::steady_clock::now();
+        const Snapshot *source = startupSnapshot.get();
+        bool verified;
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            verified = verifiedSnapshotTables & (1u << table); // by an earlier id lookup
+        }
+        if(source && !verified && !source->verify(static_cast<Snapshot::Table>(table))) {
+            std::cerr << "Ignoring binary snapshot of " << loader.name << ": checksum mismatch" << std::endl;
+            source = nullptr;
+        }
+        try {
+            (this->*loader.load)(source);
+        } catch(...) {
+            // call_once runs the loader again on the next use; it must
+            // start from an empty table, not the rows loaded so far.
+            unloadTable(table);
+            throw;
+        }
+        loadTimes[table] = TableLoadTime{loader.name, loader.rows(*this),
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()};
+        // The last table in unmaps the snapshot; no loader reads it any more.
+        unsigned loaded = loadedTables.fetch_or(1u << table, std::memory_order_acq_rel) | (1u << table);
+        if(loaded == AllTables) {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            startupSnapshot.reset();
+        }
+    });
+}
+
+template <typename T, typename Find, typename Convert>
+std::optional<const T*> CRMSystem::lookupInSnapshot(std::size_t table, int id, std::unordered_map<int, T> &cache,
+                                                    Find find, Convert convert) const {
+    unsigned bit = 1u << table;
+    if(loadedTables.load(std::memory_order_acquire) & bit)
+        return std::nullopt;
+    // Held throughout, so the last loader cannot unmap the snapshot under us.
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    if(!startupSnapshot || (corruptSnapshotTables & bit) || (loadedTables.load(std::memory_order_acquire) & bit))
+        return std::nullopt;
+    if(!(verifiedSnapshotTables & bit)) {
+        if(!startupSnapshot->verify(static_cast<Snapshot::Table>(table))) {
+            corruptSnapshotTables |= bit; // the load reports it and reads the CSV
+            return std::nullopt;
+        }
+        verifiedSnapshotTables |= bit;
+    }
+    auto cached = cache.find(id);
+    if(cached != cache.end())
+        return &cached->second;
+    const auto *record = ((*startupSnapshot).*find)(id);
+    if(!record)
+        return static_cast<const T*>(nullptr);
+    return &cache.emplace(id, ((*startupSnapshot).*convert)(*record)).first->second;
+}
+
+void CRMSystem::unloadTable(std::size_t table) {
+    switch(table) {
+    case 0:
+        agents.clear();
+        agentIndex.clear();
+        agentNames.clear();
+        agentTenures.clear();
+        agentEmails.clear();
+        agentPhones.clear();
+        break;
+    case 1:
+        clients.clear();
+        clientIndex.clear();
+        clientNames.clear();
+        clientEmails.clear();
+        clientPhones.clear();
+        break;
+    case 2:
+        properties.clear();
+        propertyIndex.clear();
+        propertySearchIndex.clear();
+        propertyColumns.clear();
+        break;
+    case 3:
+        contracts.clear();
+        contractIndex.clear();
+        contractsByProperty.clear();
+        contractsByClient.clear();
+        contractsByAgent.clear();
+        contractPeriods.clear();
+        propertyTimelines.clear();
+        break;
+    case 4:
+        inspections.clear();
+        inspectionIndex.clear();
+        agentCalendars.clear();
+        propertyCalendars.clear();
+        break;
+    }
+}
+
+void CRMSystem::prefetchTables() {
+    if(prefetcher.joinable() || loadedTables.load(std::memory_order_acquire) == AllTables)
+        return;
+    prefetcher = std::thread([this]() {
         try {
-            a.setId(std::stoi(tokens[0]));
+            ensureLoaded(AllTables);
+        } catch(const std::exception &e) {
+            // The table's next use retries the load and reports the error.
+            std::cerr << "Error prefetching tables: " << e.what() << std::endl;
+        }
+    });
+}
+
+std::vector<CRMSystem::TableLoadTime> CRMSystem::getLoadTimes() const {
+    unsigned loaded = loadedTables.load(std::memory_order_acquire);
+    std::vector<TableLoadTime> result;
+    for(std::size_t t = 0; t < loadTimes.size(); ++t) {
+        if(loaded & (1u << t))
+            result.push_back(loadTimes[t]);
+    }
+    return result;
+}
+
+void CRMSystem::saveBinarySnapshot() {
+    // flush() only writes tables that were loaded and changed, so when the
+    // CSV files still match the snapshot nothing has to be parsed at all.
+    flush();
+    if(currentSnapshot())
+        return;
+    // Also unmaps the startup snapshot, which is about to be replaced.
+    ensureLoaded(AllTables);
+    Snapshot::SourceStamp sources[Snapshot::kTableCount] = {
+        sourceStamp(kAgentsFile), sourceStamp(kClientsFile), sourceStamp(kPropertiesFile),
+        sourceStamp(kContractsFile), sourceStamp(kInspectionsFile)};
+    Snapshot::write(tempPath(kSnapshotFile), agents, clients, properties, contracts, inspections, sources);
+    commitTables({kSnapshotFile});
+}
+
+// Appends the rows added since the last flush and syncs the file. A crash
+// mid-append can leave a torn last row; the journal still holds those rows
+// until the checkpoint, and replaying them repairs it.
+template <typename T>
+static void appendRows(const char *path, const SlotMap<T> &table,
+                       const std::unordered_map<int, typename SlotMap<T>::Handle> &index,
+                       std::vector<int> &ids, void (*writeRow)(std::ostream &, const T &)) {
+    if(ids.empty())
+        return;
+    std::ofstream out(path, std::ios::app);
+    if(!out) {
+        throw FileOperationException(path, "append");
+    }
+    for(int id : ids) {
+        writeRow(out, *table.get(index.at(id)));
+    }
+    out.close();
+    if(!out || !syncPath(path)) {
+        throw FileOperationException(path, "append");
+    }
+    ids.clear();
+}
+
+// Rewritten tables go through temp files and are committed together;
+// insert-only tables are appended in place.
+void CRMSystem::flush() {
+    std::vector<const char *> rewritten;
+    if(agentChanges.rewrite) {
+        saveAgents(tempPath(kAgentsFile));
+        rewritten.push_back(kAgentsFile);
+    }
+    if(clientChanges.rewrite) {
+        saveClients(tempPath(kClientsFile));
+        rewritten.push_back(kClientsFile);
+    }
+    if(propertyChanges.rewrite) {
+        saveProperties(tempPath(kPropertiesFile));
+        rewritten.push_back(kPropertiesFile);
+    }
+    if(contractChanges.rewrite) {
+        saveContracts(tempPath(kContractsFile));
+        rewritten.push_back(kContractsFile);
+    }
+    if(inspectionChanges.rewrite) {
+        saveInspections(tempPath(kInspectionsFile));
+        rewritten.push_back(kInspectionsFile);
+    }
+
+    if(!agentChanges.rewrite)
+        appendRows(kAgentsFile, agents, agentIndex, agentChanges.appended, writeAgentRow);
+    if(!clientChanges.rewrite)
+        appendRows(kClientsFile, clients, clientIndex, clientChanges.appended, writeClientRow);
+    if(!propertyChanges.rewrite)
+        appendRows(kPropertiesFile, properties, propertyIndex, propertyChanges.appended, writePropertyRow);
+    if(!contractChanges.rewrite)
+        appendRows(kContractsFile, contracts, contractIndex, contractChanges.appended, writeContractRow);
+    if(!inspectionChanges.rewrite)
+        appendRows(kInspectionsFile, inspections, inspectionIndex, inspectionChanges.appended, writeInspectionRow);
+
+    commitTables(rewritten);
+    agentChanges = clientChanges = propertyChanges = contractChanges = inspectionChanges = TableChanges();
+
+    if(journal) journal->checkpoint();
+}
+
+void CRMSystem::loadAgents(const Snapshot *snapshot) {
+    std::vector<std::vector<ParsedRow<Agent>>> chunks;
+    if(snapshot) {
+        chunks = snapshotRows(*snapshot, snapshot->agents(), snapshot->count(Snapshot::Agents), &Snapshot::toAgent);
+    } else {
+        MappedFile file(kAgentsFile);
+        if(!file.isOpen()) return;
+        // Expected 7 tokens: id,firstName,lastName,phone,email,startDate,endDate
+        chunks = parseCSVFile<Agent>(file, 7, parseAgentRow, file.size() > kParallelParseBytes ? &workers() : nullptr);
+    }
+    std::size_t count = rowCount(chunks);
+    agents.reserve(count);
+    agentIndex.reserve(count);
+    int maxId = 0;
+    for(auto &chunk : chunks) {
+        for(auto &parsed : chunk) {
+            if(!parsed.row) {
+                std::cerr << "Error parsing agent (" << toString(parsed.row.error()) << "): " << parsed.line << std::endl;
+                continue;
+            }
+            Agent &a = *parsed.row;
             if(a.getId() > maxId) maxId = a.getId();
-            a.setFirstName(tokens[1]);
-            a.setLastName(tokens[2]);
-            a.setPhone(tokens[3]);
-            a.setEmail(tokens[4]);
-            a.setStartDateFromString(tokens[5]);
-            a.setEndDateFromString(tokens[6]);
-            agents.push_back(a);
-        } catch (const std::exception& e) {
-            // Log or handle parsing errors
-            std::cerr << "Error parsing agent: " << e.what() << std::endl;
+            if(agentIndex.count(a.getId())) {
+                std::cerr << "Skipping duplicate agent ID: " << a.getId() << std::endl;
+                continue;
+            }
+            agentNames.insert(a.getId(), a.getFirstName(), a.getLastName());
+            agentTenures.insert(a.getId(), a.getStartDate(), a.getEndDate());
+            agentIndex.emplace(a.getId(), agents.insert(std::move(a)));
         }
     }
-    in.close();
     nextAgentId = maxId + 1;
+    rebuildAgentContacts();
 }
 
-void CRMSystem::saveAgents() {
-    std::ofstream out("agents_data.csv");
+// Rows already on disk may predate the uniqueness rule, so duplicates are
+// reported and kept; the first row keeps the index entry and the others
+// take it over in turn as the rows ahead of them are removed or changed.
+void CRMSystem::rebuildAgentContacts() {
+    agentEmails.clear();
+    agentPhones.clear();
+    agentEmails.reserve(agents.size());
+    agentPhones.reserve(agents.size());
+    for(const auto &a : agents) {
+        if(!agentEmails.claim(a.getEmail(), a.getId()))
+            std::cerr << "Duplicate agent email for ID " << a.getId() << ": " << a.getEmail() << std::endl;
+        if(!agentPhones.claim(a.getPhone(), a.getId()))
+            std::cerr << "Duplicate agent phone for ID " << a.getId() << ": " << a.getPhone() << std::endl;
+    }
+}
+
+void CRMSystem::saveAgents(const std::string &path) const {
+    std::ofstream out(path);
     if(!out) {
-        throw FileOperationException("agents_data.csv", "write");
+        throw FileOperationException(path, "write");
     }
     for(const auto &a : agents) {
-        out << a.getId() << ","
-            << a.getFirstName() << ","
-            << a.getLastName() << ","
-            << a.getPhone() << ","
-            << a.getEmail() << ","
-            << a.getStartDateString() << ","
-            << a.getEndDateString() << "\n";
+        writeAgentRow(out, a);
     }
     out.close();
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
+    if(!syncPath(path)) {
+        throw FileOperationException(path, "sync");
+    }
 }
 
-void CRMSystem::loadClients() {
-    std::ifstream in("clients_data.csv");
-    int maxId = 0;
-    if(!in) return;
-    std::string line;
-    while(std::getline(in, line)) {
-        if(line.empty()) continue;
-        auto tokens = splitCSV(line);
+void CRMSystem::loadClients(const Snapshot *snapshot) {
+    std::vector<std::vector<ParsedRow<Client>>> chunks;
+    if(snapshot) {
+        chunks = snapshotRows(*snapshot, snapshot->clients(), snapshot->count(Snapshot::Clients), &Snapshot::toClient);
+    } else {
+        MappedFile file(kClientsFile);
+        if(!file.isOpen()) return;
         // Expected 8 tokens: id,firstName,lastName,phone,email,isMarried,budget,budgetType
-        if(tokens.size() < 8) continue;
-        Client c;
-        c.setId(std::stoi(tokens[0]));
-        if(c.getId() > maxId) maxId = c.getId();
-        c.setFirstName(tokens[1]);
-        c.setLastName(tokens[2]);
-        c.setPhone(tokens[3]);
-        c.setEmail(tokens[4]);
-        bool married = (std::stoi(tokens[5]) != 0);
-        c.setIsMarried(married);
-        c.setBudget(std::stod(tokens[6]));
-        c.setBudgetType(tokens[7]);
-        clients.push_back(c);
-    }
-    in.close();
+        chunks = parseCSVFile<Client>(file, 8, parseClientRow, file.size() > kParallelParseBytes ? &workers() : nullptr);
+    }
+    std::size_t count = rowCount(chunks);
+    clients.reserve(count);
+    clientIndex.reserve(count);
+    int maxId = 0;
+    for(auto &chunk : chunks) {
+        for(auto &parsed : chunk) {
+            if(!parsed.row) {
+                std::cerr << "Error parsing client (" << toString(parsed.row.error()) << "): " << parsed.line << std::endl;
+                continue;
+            }
+            Client &c = *parsed.row;
+            if(c.getId() > maxId) maxId = c.getId();
+            if(clientIndex.count(c.getId())) {
+                std::cerr << "Skipping duplicate client ID: " << c.getId() << std::endl;
+                continue;
+            }
+            clientNames.insert(c.getId(), c.getFirstName(), c.getLastName());
+            clientIndex.emplace(c.getId(), clients.insert(std::move(c)));
+        }
+    }
     nextClientId = maxId + 1;
+    rebuildClientContacts();
+}
+
+// Rows already on disk may predate the uniqueness rule, so duplicates are
+// reported and kept; the first row keeps the index entry and the others
+// take it over in turn as the rows ahead of them are removed or changed.
+void CRMSystem::rebuildClientContacts() {
+    clientEmails.clear();
+    clientPhones.clear();
+    clientEmails.reserve(clients.size());
+    clientPhones.reserve(clients.size());
+    for(const auto &c : clients) {
+        if(!clientEmails.claim(c.getEmail(), c.getId()))
+            std::cerr << "Duplicate client email for ID " << c.getId() << ": " << c.getEmail() << std::endl;
+        if(!clientPhones.claim(c.getPhone(), c.getId()))
+            std::cerr << "Duplicate client phone for ID " << c.getId() << ": " << c.getPhone() << std::endl;
+    }
 }
 
-void CRMSystem::saveClients() {
-    std::ofstream out("clients_data.csv");
+void CRMSystem::saveClients(const std::string &path) const {
+    std::ofstream out(path);
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
     for(const auto &c : clients) {
-        out << c.getId() << ","
-            << c.getFirstName() << ","
-            << c.getLastName() << ","
-            << c.getPhone() << ","
-            << c.getEmail() << ","
-            << (c.getIsMarried() ? 1 : 0) << ","
-            << c.getBudget() << ","
-            << c.getBudgetType() << "\n";
+        writeClientRow(out, c);
     }
     out.close();
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
+    if(!syncPath(path)) {
+        throw FileOperationException(path, "sync");
+    }
 }
 
-void CRMSystem::loadProperties() {
-    std::ifstream in("properties_data.csv");
-    int maxId = 0;
-    if(!in) return;
-    std::string line;
-    while(std::getline(in, line)) {
-        if(line.empty()) continue;
-        auto tokens = splitCSV(line);
+void CRMSystem::loadProperties(const Snapshot *snapshot) {
+    std::vector<std::vector<ParsedRow<Property>>> chunks;
+    if(snapshot) {
+        chunks = snapshotRows(*snapshot, snapshot->properties(), snapshot->count(Snapshot::Properties), &Snapshot::toProperty);
+    } else {
+        MappedFile file(kPropertiesFile);
+        if(!file.isOpen()) return;
         // Expected 9 tokens: id,sizeSqm,price,propertyType,bedrooms,bathrooms,place,available,listingType
-        if(tokens.size() < 9) continue;
-        Property p;
-        p.setId(std::stoi(tokens[0]));
-        if(p.getId() > maxId) maxId = p.getId();
-        p.setSizeSqm(std::stod(tokens[1]));
-        p.setPrice(std::stod(tokens[2]));
-        p.setPropertyType(tokens[3]);
-        p.setBedrooms(std::stoi(tokens[4]));
-        p.setBathrooms(std::stoi(tokens[5]));
-        p.setPlace(tokens[6]);
-        p.setAvailability(std::stoi(tokens[7]) != 0);
-        p.setListingType(tokens[8]);
-        properties.push_back(p);
-    }
-    in.close();
+        chunks = parseCSVFile<Property>(file, 9, parsePropertyRow, file.size() > kParallelParseBytes ? &workers() : nullptr);
+    }
+    std::size_t count = rowCount(chunks);
+    properties.reserve(count);
+    propertyIndex.reserve(count);
+    int maxId = 0;
+    for(auto &chunk : chunks) {
+        for(auto &parsed : chunk) {
+            if(!parsed.row) {
+                std::cerr << "Error parsing property (" << toString(parsed.row.error()) << "): " << parsed.line << std::endl;
+                continue;
+            }
+            Property &p = *parsed.row;
+            if(p.getId() > maxId) maxId = p.getId();
+            if(propertyIndex.count(p.getId())) {
+                std::cerr << "Skipping duplicate property ID: " << p.getId() << std::endl;
+                continue;
+            }
+            propertySearchIndex.insert(p);
+            if(propertyColumnsEnabled)
+                propertyColumns.insert(p);
+            propertyIndex.emplace(p.getId(), properties.insert(std::move(p)));
+        }
+    }
     nextPropertyId = maxId + 1;
 }
 
-void CRMSystem::saveProperties() {
-    std::ofstream out("properties_data.csv");
+void CRMSystem::saveProperties(const std::string &path) const {
+    std::ofstream out(path);
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
     for(const auto &p : properties) {
-        out << p.getId() << ","
-            << p.getSizeSqm() << ","
-            << p.getPrice() << ","
-            << p.getPropertyType() << ","
-            << p.getBedrooms() << ","
-            << p.getBathrooms() << ","
-            << p.getPlace() << ","
-            << (p.getAvailability() ? 1 : 0) << ","
-            << p.getListingType() << "\n";
+        writePropertyRow(out, p);
     }
     out.close();
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
+    if(!syncPath(path)) {
+        throw FileOperationException(path, "sync");
+    }
 }
 
-void CRMSystem::loadContracts() {
-    std::ifstream in("contracts_data.csv");
-    int maxId = 0;
-    if(!in) return;
-    std::string line;
-    while(std::getline(in, line)) {
-        if(line.empty()) continue;
-        auto tokens = splitCSV(line);
+void CRMSystem::loadContracts(const Snapshot *snapshot) {
+    std::vector<std::vector<ParsedRow<Contract>>> chunks;
+    if(snapshot) {
+        chunks = snapshotRows(*snapshot, snapshot->contracts(), snapshot->count(Snapshot::Contracts), &Snapshot::toContract);
+    } else {
+        MappedFile file(kContractsFile);
+        if(!file.isOpen()) return;
         // Expected 9 tokens: id,propertyId,clientId,agentId,price,startDate,endDate,contractType,isActive
-        if(tokens.size() < 9) continue;
-        Contract ct;
-        ct.setId(std::stoi(tokens[0]));
-        if(ct.getId() > maxId) maxId = ct.getId();
-        ct.setPropertyId(std::stoi(tokens[1]));
-        ct.setClientId(std::stoi(tokens[2]));
-        ct.setAgentId(std::stoi(tokens[3]));
-        ct.setPrice(std::stod(tokens[4]));
-        ct.setStartDateFromString(tokens[5]);
-        ct.setEndDateFromString(tokens[6]);
-        ct.setContractType(tokens[7]);
-        ct.setIsActive(std::stoi(tokens[8]) != 0);
-        contracts.push_back(ct);
-    }
-    in.close();
+        chunks = parseCSVFile<Contract>(file, 9, parseContractRow, file.size() > kParallelParseBytes ? &workers() : nullptr);
+    }
+    std::size_t count = rowCount(chunks);
+    contracts.reserve(count);
+    contractIndex.reserve(count);
+    int maxId = 0;
+    for(auto &chunk : chunks) {
+        for(auto &parsed : chunk) {
+            if(!parsed.row) {
+                std::cerr << "Error parsing contract (" << toString(parsed.row.error()) << "): " << parsed.line << std::endl;
+                continue;
+            }
+            Contract &ct = *parsed.row;
+            if(ct.getId() > maxId) maxId = ct.getId();
+            if(contractIndex.count(ct.getId())) {
+                std::cerr << "Skipping duplicate contract ID: " << ct.getId() << std::endl;
+                continue;
+            }
+            // Overlapping bookings already on disk are kept but left off the
+            // property timeline.
+            int conflict = bookingConflict(ct);
+            if(conflict != -1)
+                std::cerr << "Contract " << ct.getId() << " overlaps contract " << conflict
+                          << " on property " << ct.getPropertyId() << std::endl;
+            linkContract(ct);
+            contractIndex.emplace(ct.getId(), contracts.insert(std::move(ct)));
+        }
+    }
     nextContractId = maxId + 1;
 }
 
-void CRMSystem::saveContracts() {
-    std::ofstream out("contracts_data.csv");
+void CRMSystem::saveContracts(const std::string &path) const {
+    std::ofstream out(path);
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
     for(const auto &c : contracts) {
-        out << c.getId() << ","
-            << c.getPropertyId() << ","
-            << c.getClientId() << ","
-            << c.getAgentId() << ","
-            << c.getPrice() << ","
-            << c.getStartDateString() << ","  
-            << c.getEndDateString() << "," 
-            << c.getContractType() << ","
-            << (c.getIsActive() ? 1 : 0) << "\n";
+        writeContractRow(out, c);
     }
     out.close();
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
+    if(!syncPath(path)) {
+        throw FileOperationException(path, "sync");
+    }
+}
+
+void CRMSystem::loadInspections(const Snapshot *snapshot) {
+    std::vector<std::vector<ParsedRow<Inspection>>> chunks;
+    if(snapshot) {
+        chunks = snapshotRows(*snapshot, snapshot->inspections(), snapshot->count(Snapshot::Inspections), &Snapshot::toInspection);
+    } else {
+        MappedFile file(kInspectionsFile);
+        if(!file.isOpen()) return;
+        // Expected tokens: id,agentId,propertyId,dateTime,durationMinutes[,notes]
+        chunks = parseCSVFile<Inspection>(file, 5, parseInspectionRow, file.size() > kParallelParseBytes ? &workers() : nullptr);
+    }
+    std::size_t count = rowCount(chunks);
+    inspections.reserve(count);
+    inspectionIndex.reserve(count);
+    int maxId = 0;
+    for(auto &chunk : chunks) {
+        for(auto &parsed : chunk) {
+            if(!parsed.row) {
+                std::cerr << "Error parsing inspection (" << toString(parsed.row.error()) << "): " << parsed.line << std::endl;
+                continue;
+            }
+            Inspection &i = *parsed.row;
+            if(i.getId() > maxId) maxId = i.getId();
+            if(inspectionIndex.count(i.getId())) {
+                std::cerr << "Skipping duplicate inspection ID: " << i.getId() << std::endl;
+                continue;
+            }
+            // Every stored inspection must be on both calendars, which the
+            // "for X" queries and the remove checks read, so double bookings
+            // already on disk are skipped like duplicate ids.
+            int conflict = inspectionConflict(i);
+            if(conflict != -1) {
+                std::cerr << "Skipping inspection " << i.getId() << ": overlaps inspection " << conflict << std::endl;
+                continue;
+            }
+            bookInspection(i);
+            inspectionIndex.emplace(i.getId(), inspections.insert(std::move(i)));
+        }
+    }
+    nextInspectionId = maxId + 1;
+}
+
+void CRMSystem::saveInspections(const std::string &path) const {
+    std::ofstream out(path);
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
+    for(const auto &i : inspections) {
+        writeInspectionRow(out, i);
+    }
+    out.close();
+    if(!out) {
+        throw FileOperationException(path, "write");
+    }
+    if(!syncPath(path)) {
+        throw FileOperationException(path, "sync");
+    }
 }
@@ -3,6 +3,12 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include "Agent.h"
 #include "Client.h"
 #include "Property.h"
@@ -10,69 +16,383 @@
 #include "Inspection.h"
 #include "Exceptions.h"
 #include "Date.h"
+#include "SlotMap.h"
+#include "PropertyIndex.h"
+#include "PropertyColumns.h"
+#include "Matchmaker.h"
+#include "ThreadPool.h"
+#include "NameIndex.h"
+#include "UniqueIndex.h"
+#include "Result.h"
+#include "IntervalIndex.h"
+#include "PropertyTimeline.h"
+#include "InspectionCalendar.h"
+#include "Journal.h"
+
+class Snapshot;
+
 class CRMSystem {
 public:
-    CRMSystem();
-    ~CRMSystem();
+    // Stable handles into the entity tables; they survive other inserts and
+    // deletes and are rejected once the entity they refer to is removed.
+    using AgentHandle = SlotMap<Agent>::Handle;
+    using ClientHandle = SlotMap<Client>::Handle;
+    using PropertyHandle = SlotMap<Property>::Handle;
+    using ContractHandle = SlotMap<Contract>::Handle;
+    using InspectionHandle = SlotMap<Inspection>::Handle;
+
+    // Tables are loaded on first use, from the binary snapshot when it is
+    // current and from the CSV files otherwise, so construction only reads
+    // the tables the first request needs. If journal.log is not empty
+    // every table is loaded and the journal replayed on top: every
+    // mutation is journaled as it happens and the journal is emptied by
+    // flush(), so whatever it still holds was lost by a crash.
+    // Threading: members are not synchronized. Call them from one thread,
+    // or from several only while none of them mutates the system. Table
+    // loading is the one exception: ensureLoaded checks the loaded bits
+    // and then loads through std::call_once, and each loader writes only
+    // its own table, so a call that needs a table still being loaded (by
+    // prefetchTables or another reader) waits for it. That check-then-load
+    // is safe only with a single mutating thread.
+    explicit CRMSystem(Journal::SyncPolicy journalPolicy = Journal::SyncPolicy::EveryCommit);
+    ~CRMSystem(); // joins the prefetch thread, then flushes (errors are logged)
+
+    // Starts loading the tables nobody has asked for yet on a background
+    // thread, so later first uses do not wait. Optional: without it every
+    // table still loads on first use. Further calls do nothing.
+    void prefetchTables();
+
+    // Writes pending changes to the CSV files. Tables with only new
+    // records since the last flush get them appended; a table with any
+    // modify or remove is rewritten; untouched tables are left alone.
+    // Rewritten tables replace the old files atomically and as one set
+    // (see commitTables). Checkpoints (empties) the journal afterwards.
+    // Rewrites cost a full table write, so call it at save points (exit,
+    // explicit saves), not after every change; the journal keeps changes
+    // durable in between.
+    void flush();
+
+    // Flushes, then writes crm_data.snap, a binary image of every table.
+    // Startup loads from it instead of parsing the CSV files for as long
+    // as none of them is written again. Does nothing, and loads no table,
+    // if the snapshot still matches the CSV files' sizes and mtimes.
+    void saveBinarySnapshot();
+
+    // How long each table loaded so far took (parse plus index building).
+    // Tables loaded together load concurrently, so their times overlap.
+    struct TableLoadTime {
+        const char *table;
+        std::size_t rows;
+        double milliseconds;
+    };
+    std::vector<TableLoadTime> getLoadTimes() const;
 
     // AGENT CRUD
+    // addX/modifyX throw DuplicateValueException when another agent (or
+    // client) already uses the email or phone; modifyX only checks values
+    // that change.
+    // removeClient throws ValidationException while contracts still
+    // reference the client; removeAgent/removeProperty while contracts or
+    // inspections still reference the agent/property.
+    // tryAddX/tryCreateContract run the same checks as addX/createContract
+    // but report failures as an ErrorCode instead of throwing. They return
+    // the stored id and move from the record only when they succeed.
+    // searchXById returns a copy; findX/getXById read the stored record in
+    // place and stay valid until the next mutation of that table. Until a
+    // table is loaded they are answered from the binary snapshot, by a
+    // binary search of its mapped records, without loading the table.
     void addAgent(const Agent &agent);
+    void addAgent(Agent &&agent);
+    Result<int> tryAddAgent(Agent &&agent);
     bool removeAgent(int agentId);
     Agent searchAgentById(int agentId) const;
+    const Agent* findAgent(int agentId) const;     // nullptr if absent
+    const Agent& getAgentById(int agentId) const;  // throws AgentNotFoundException
     bool modifyAgent(const Agent &modifiedAgent);
+    bool modifyAgent(Agent &&modifiedAgent);
     void displayAgents() const;
+    AgentHandle getAgentHandle(int agentId) const; // invalid handle if absent
+    const Agent* getAgent(AgentHandle handle) const;  // nullptr if stale
 
     // CLIENT CRUD
     void addClient(const Client &client);
+    void addClient(Client &&client);
+    Result<int> tryAddClient(Client &&client);
     bool removeClient(int clientId);
     Client searchClientById(int clientId) const;
+    const Client* findClient(int clientId) const;     // nullptr if absent
+    const Client& getClientById(int clientId) const;  // throws ClientNotFoundException
     bool modifyClient(const Client &modifiedClient);
+    bool modifyClient(Client &&modifiedClient);
     void displayClients() const;
+    ClientHandle getClientHandle(int clientId) const; // invalid handle if absent
+    const Client* getClient(ClientHandle handle) const;  // nullptr if stale
 
     // PROPERTY CRUD
     void addProperty(const Property &property);
+    void addProperty(Property &&property);
+    Result<int> tryAddProperty(Property &&property);
     bool removeProperty(int propertyId);
     Property searchPropertyById(int propertyId) const;
+    const Property* findProperty(int propertyId) const;     // nullptr if absent
+    const Property& getPropertyById(int propertyId) const;  // throws PropertyNotFoundException
     bool modifyProperty(const Property &modifiedProperty);
+    bool modifyProperty(Property &&modifiedProperty);
     void displayProperties() const;
+    PropertyHandle getPropertyHandle(int propertyId) const; // invalid handle if absent
+    const Property* getProperty(PropertyHandle handle) const;  // nullptr if stale
+
+    // PROPERTY SEARCH
+    // Matches are returned as pointers into the table; they are invalidated
+    // by the next mutation. Queries on a place are answered from the
+    // secondary indexes; other filters use the SIMD column scan when the
+    // columnar mirror is enabled.
+    std::vector<const Property*> findProperties(const PropertyFilter &filter) const;
+
+    // Optional columnar mirror of the property table for full-table scans
+    // and aggregates. Enabling it builds the mirror from the current table;
+    // while disabled, scans fall back to the row objects.
+    void setPropertyColumnsEnabled(bool enabled);
+    bool isPropertyColumnsEnabled() const;
+    std::vector<const Property*> scanProperties(const PropertyFilter &filter) const;
+    PropertyStats propertyStats(const PropertyFilter &filter) const;
+
+    // PLACES
+    // Properties in a place, straight from the inverted place index.
+    std::vector<const Property*> getPropertiesInPlace(const std::string &place) const;
+    // Report helpers grouped by PlaceDictionary id (see Property::getPlaceId).
+    std::unordered_map<std::uint32_t, std::size_t> countPropertiesByPlace() const;
+    std::unordered_map<std::uint32_t, PropertyStats> propertyStatsByPlace(const PropertyFilter &filter) const;
 
     // CONTRACT CRUD
     void addContract(const Contract &contract);
+    void addContract(Contract &&contract);
+    Result<int> tryAddContract(Contract &&contract);
     bool removeContract(int contractId);
     Contract searchContractById(int contractId) const;
+    const Contract* findContract(int contractId) const;     // nullptr if absent
+    const Contract& getContractById(int contractId) const;  // throws ContractNotFoundException
     bool modifyContract(const Contract &modifiedContract);
+    bool modifyContract(Contract &&modifiedContract);
     void displayContracts() const;
+    ContractHandle getContractHandle(int contractId) const; // invalid handle if absent
+    const Contract* getContract(ContractHandle handle) const;  // nullptr if stale
+
+    // CONTACT LOOKUPS
+    // Emails match case-insensitively, phones on their digits only.
+    // nullptr if no record has the value.
+    const Agent* findAgentByEmail(const std::string &email) const;
+    const Agent* findAgentByPhone(const std::string &phone) const;
+    const Client* findClientByEmail(const std::string &email) const;
+    const Client* findClientByPhone(const std::string &phone) const;
+
+    // INSPECTIONS
+    // An inspection books its agent and its property for [start, start +
+    // duration); times are minutes since the epoch (see Inspection).
+    // Scheduling or moving an inspection onto a busy agent or property
+    // fails with ErrorCode::BookingConflict (ValidationException when
+    // thrown), as does pointing it at an agent or property that does not
+    // exist. Loading skips stored inspections that double-book either.
+    void scheduleInspection(const Inspection &inspection);
+    Result<int> tryScheduleInspection(Inspection &&inspection);
+    bool cancelInspection(int inspectionId);
+    bool modifyInspection(const Inspection &modifiedInspection);
+    const Inspection* findInspection(int inspectionId) const; // nullptr if absent
+    void displayInspections() const;
+    // In start order.
+    std::vector<const Inspection*> getInspectionsForAgent(int agentId) const;
+    std::vector<const Inspection*> getInspectionsForProperty(int propertyId) const;
+    // Id of an inspection of the agent overlapping [start, end), or -1.
+    int agentInspectionConflict(int agentId, std::int32_t start, std::int32_t end) const;
+    // The next `count` slot starts at or after `fromMinute` when both the
+    // agent and the property are free, on the options' office-hours grid.
+    std::vector<std::int32_t> suggestInspectionSlots(int agentId, int propertyId, std::int32_t fromMinute,
+                                                     std::size_t count, const SlotOptions &options = SlotOptions()) const;
+
+    // NAME AUTOCOMPLETE
+    // People whose "first last" or "last first" name starts with the prefix
+    // (case-insensitive), in name order.
+    std::vector<const Agent*> autocompleteAgents(const std::string &prefix, std::size_t limit = 10) const;
+    std::vector<const Client*> autocompleteClients(const std::string &prefix, std::size_t limit = 10) const;
+
+    // MATCHMAKING
+    // Top-K available listings per client, ranked by budget fit and size per
+    // price. "rent" budgets match rent listings, "buy" budgets sale listings.
+    std::vector<ClientMatches> matchClients(const MatchOptions &options = MatchOptions()) const;
+    ClientMatches matchClient(int clientId, const MatchOptions &options = MatchOptions()) const;
+
+    // CONTRACT LOOKUPS (served from the reverse foreign-key indexes)
+    std::vector<const Contract*> getContractsForProperty(int propertyId) const;
+    std::vector<const Contract*> getContractsForClient(int clientId) const;
+    std::vector<const Contract*> getContractsForAgent(int agentId) const;
+    bool isPropertyUnderActiveContract(int propertyId) const;
+    bool hasContractsForAgent(int agentId) const;
+    bool hasContractsForClient(int clientId) const;
+
+    // DATE-RANGE QUERIES
+    // Served from interval indexes over contract periods and agent
+    // tenures; an empty end date counts as still running. "Active" here is
+    // about the period only, not the contract's isActive flag.
+    std::vector<const Contract*> contractsActiveOn(const Date &day) const;
+    std::vector<const Contract*> contractsOverlapping(const Date &from, const Date &to) const;
+    std::vector<const Contract*> contractsStartingBetween(const Date &from, const Date &to) const;
+    std::vector<const Agent*> agentsEmployedOn(const Date &day) const;
+    std::vector<const Agent*> agentsEmployedDuring(const Date &from, const Date &to) const;
+
+    // BOOKINGS
+    // Active contracts book their property: a rent for its period, a sale
+    // from its start date on. Adding or modifying a contract, active or
+    // not, whose period computed the same way overlaps an active booking on
+    // the same property is rejected; inactive contracts book nothing.
+    // Unbooked ranges of a property inside [from, to]; throws
+    // PropertyNotFoundException for an unknown property.
+    std::vector<DateRange> freePeriods(int propertyId, const Date &from, const Date &to) const;
 
     // Create a contract from existing records
     void createContract(int contractId, int propertyId, int clientId, int agentId,
                         double price, const std::string &startDate,
                         const std::string &endDate, const std::string &contractType, bool isActive);
+    Result<int> tryCreateContract(int propertyId, int clientId, int agentId,
+                                  double price, const std::string &startDate,
+                                  const std::string &endDate, const std::string &contractType, bool isActive);
 
 private:
-    std::vector<Agent> agents;
-    std::vector<Client> clients;
-    std::vector<Property> properties;
-    std::vector<Contract> contracts;
-    std::vector<Inspection> inspections; // Optional
+    SlotMap<Agent> agents;
+    SlotMap<Client> clients;
+    SlotMap<Property> properties;
+    SlotMap<Contract> contracts;
+    SlotMap<Inspection> inspections;
+
+    // Primary-key indexes: entity id -> handle into the table above
+    std::unordered_map<int, AgentHandle> agentIndex;
+    std::unordered_map<int, ClientHandle> clientIndex;
+    std::unordered_map<int, PropertyHandle> propertyIndex;
+    std::unordered_map<int, ContractHandle> contractIndex;
+    std::unordered_map<int, InspectionHandle> inspectionIndex;
+
+    // Secondary indexes for findProperties
+    PropertyIndex propertySearchIndex;
+    PropertyColumns propertyColumns;
+    bool propertyColumnsEnabled = false;
+
+    // Prefix indexes over agent and client names
+    NameIndex agentNames;
+    NameIndex clientNames;
+
+    // Unique indexes over contact details; rebuilt in one pass after loading
+    UniqueIndex agentEmails{UniqueIndex::normalizeEmail};
+    UniqueIndex agentPhones{UniqueIndex::normalizePhone};
+    UniqueIndex clientEmails{UniqueIndex::normalizeEmail};
+    UniqueIndex clientPhones{UniqueIndex::normalizePhone};
+    void rebuildAgentContacts();
+    void rebuildClientContacts();
+
+    // Date intervals: contract start/end and agent employment
+    IntervalIndex contractPeriods;
+    IntervalIndex agentTenures;
+    std::vector<const Contract*> contractsWithIds(const std::vector<int> &ids) const;
+    std::vector<const Agent*> agentsWithIds(const std::vector<int> &ids) const;
+
+    // Per-property timelines of active contracts
+    std::unordered_map<int, PropertyTimeline> propertyTimelines;
+    int bookingConflict(const Contract &contract) const; // conflicting contract id, or -1
+
+    // Inspection calendars per agent and per property
+    std::unordered_map<int, InspectionCalendar> agentCalendars;
+    std::unordered_map<int, InspectionCalendar> propertyCalendars;
+    int inspectionConflict(const Inspection &inspection) const; // conflicting inspection id, or -1
+    void bookInspection(const Inspection &inspection);
+    void releaseInspection(const Inspection &inspection);
+    std::vector<const Inspection*> calendarInspections(const std::unordered_map<int, InspectionCalendar> &calendars,
+                                                       int key) const;
+
+    // Reverse foreign-key indexes: referenced id -> contract id
+    std::unordered_multimap<int, int> contractsByProperty;
+    std::unordered_multimap<int, int> contractsByClient;
+    std::unordered_multimap<int, int> contractsByAgent;
+    void linkContract(const Contract &contract);
+    void unlinkContract(const Contract &contract);
+    std::vector<const Contract*> contractsFor(const std::unordered_multimap<int, int> &index, int key) const;
+
+    // Worker threads for batch jobs, started on first use
+    mutable std::unique_ptr<ThreadPool> workerPool;
+    mutable std::once_flag workerPoolStarted;
+    ThreadPool &workers() const;
+    Matchmaker buildMatchmaker(const MatchOptions &options) const;
 
     // Auto-generated ID counters
     int nextAgentId;
     int nextClientId;
     int nextPropertyId;
     int nextContractId;
+    int nextInspectionId;
+
+    // Changes since the last flush, per table
+    struct TableChanges {
+        bool rewrite = false;       // a record was modified or removed
+        std::vector<int> appended;  // ids added since the last flush
+    };
+    TableChanges agentChanges;
+    TableChanges clientChanges;
+    TableChanges propertyChanges;
+    TableChanges contractChanges;
+    TableChanges inspectionChanges;
+
+    // Lazy loading. Every public member first calls ensureLoaded with the
+    // tables it reads or checks; each table is loaded exactly once, and
+    // tables missing together are loaded concurrently. Loaders must not
+    // call public members: waiting on their own table would deadlock.
+    enum LoadTable : unsigned {
+        AgentsTable = 1,
+        ClientsTable = 2,
+        PropertiesTable = 4,
+        ContractsTable = 8,
+        InspectionsTable = 16,
+        AllTables = 31
+    };
+    void ensureLoaded(unsigned tables) const;
+    void loadTable(std::size_t table); // index of its LoadTable bit
+    void unloadTable(std::size_t table); // empties it after a failed load
+    mutable std::once_flag tableLoads[5];
+    std::atomic<unsigned> loadedTables{0};
+    std::unique_ptr<Snapshot> startupSnapshot; // dropped once every table is loaded
+    std::thread prefetcher;
+
+    // Id lookups on tables not loaded yet, served from startupSnapshot.
+    // Each table's section is verified on its first lookup; records found
+    // are materialized into the caches below, whose entries stay put, so
+    // the pointers handed out remain valid after the table loads.
+    // Empty optional: not served, use the loaded table.
+    template <typename T, typename Find, typename Convert>
+    std::optional<const T*> lookupInSnapshot(std::size_t table, int id, std::unordered_map<int, T> &cache,
+                                             Find find, Convert convert) const;
+    mutable std::mutex snapshotMutex;      // guards startupSnapshot's reset and the members below
+    mutable unsigned verifiedSnapshotTables = 0;
+    mutable unsigned corruptSnapshotTables = 0;
+    mutable std::unordered_map<int, Agent> snapshotAgents;
+    mutable std::unordered_map<int, Client> snapshotClients;
+    mutable std::unordered_map<int, Property> snapshotProperties;
+    mutable std::unordered_map<int, Contract> snapshotContracts;
+    mutable std::unordered_map<int, Inspection> snapshotInspections;
 
     // File persistence functions
-    void loadData();
-    void saveData();
-    void loadAgents();
-    void loadClients();
-    void loadProperties();
-    void loadContracts();
-
-    void saveAgents();
-    void saveClients();
-    void saveProperties();
-    void saveContracts();
+    void loadData(); // recovers interrupted commits and opens the snapshot
+    void loadAgents(const Snapshot *snapshot); // from the snapshot if given, else CSV
+    void loadClients(const Snapshot *snapshot);
+    void loadProperties(const Snapshot *snapshot);
+    void loadContracts(const Snapshot *snapshot);
+    void loadInspections(const Snapshot *snapshot);
+
+    // Write the whole table to `path` and fsync it
+    void saveAgents(const std::string &path) const;
+    void saveClients(const std::string &path) const;
+    void saveProperties(const std::string &path) const;
+    void saveContracts(const std::string &path) const;
+    void saveInspections(const std::string &path) const;
+
+    std::vector<TableLoadTime> loadTimes;
+    std::unique_ptr<Journal> journal; // null while loading and replaying
+    void replayRecord(const Journal::Record &record);
 };
 
 #endif // CRMSYSTEM_H
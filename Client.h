@@ -3,7 +3,9 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include "Exceptions.h"
+#include "EntityTypes.h"
 
 class Client {
 public:
@@ -14,13 +16,14 @@ public:
 
     // Getters
     int getId() const;
-    std::string getFirstName() const;
-    std::string getLastName() const;
-    std::string getPhone() const;
-    std::string getEmail() const;
+    const std::string &getFirstName() const;
+    const std::string &getLastName() const;
+    const std::string &getPhone() const;
+    const std::string &getEmail() const;
     bool getIsMarried() const;
     double getBudget() const;
-    std::string getBudgetType() const;
+    std::string_view getBudgetType() const;
+    BudgetType getBudgetTypeEnum() const;
 
     // Setters
     void setId(int id);
@@ -31,6 +34,7 @@ public:
     void setIsMarried(bool isMarried);
     void setBudget(double budget);
     void setBudgetType(const std::string &budgetType); // Must be "rent" or "buy"
+    void setBudgetType(BudgetType budgetType);
 
 
     // Validation
@@ -48,7 +52,7 @@ private:
     std::string m_email;
     bool m_isMarried;
     double m_budget;
-    std::string m_budgetType;
+    BudgetType m_budgetType;
 };
 
 #endif // CLIENT_H
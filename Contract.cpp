@@ -3,14 +3,14 @@
 #include <stdexcept>
 
 Contract::Contract() 
-    : m_id(-1), m_propertyId(-1), m_clientId(-1), m_agentId(-1), m_price(0.0), m_isActive(false), m_contractType("rent")
+    : m_id(-1), m_propertyId(-1), m_clientId(-1), m_agentId(-1), m_price(0.0), m_contractType(ContractType::Rent), m_isActive(false)
 {}
 
 Contract::Contract(int id, int propertyId, int clientId, int agentId,
                    double price, const std::string &startDate, const std::string &endDate,
                    const std::string &contractType, bool isActive)
     : m_id(id), m_propertyId(propertyId), m_clientId(clientId), m_agentId(agentId),
-      m_price(price), m_startDate(startDate), m_endDate(endDate), m_isActive(isActive)
+      m_price(price), m_startDate(startDate), m_endDate(endDate), m_contractType(ContractType::Rent), m_isActive(isActive)
 {
     setContractType(contractType);
 }
@@ -20,9 +20,10 @@ int Contract::getPropertyId() const { return m_propertyId; }
 int Contract::getClientId() const { return m_clientId; }
 int Contract::getAgentId() const { return m_agentId; }
 double Contract::getPrice() const { return m_price; }
-Date Contract::getStartDate() const { return m_startDate; }
-Date Contract::getEndDate() const { return m_endDate; }
-std::string Contract::getContractType() const { return m_contractType; }
+const Date &Contract::getStartDate() const { return m_startDate; }
+const Date &Contract::getEndDate() const { return m_endDate; }
+std::string_view Contract::getContractType() const { return toString(m_contractType); }
+ContractType Contract::getContractTypeEnum() const { return m_contractType; }
 bool Contract::getIsActive() const { return m_isActive; }
 
 void Contract::setId(int id) { m_id = id; }
@@ -52,7 +53,7 @@ void Contract::setEndDateFromString(const std::string& endDate) {
             m_endDate = Date(endDate);
             
             // Validate that end date is after start date for rental contracts
-            if (m_contractType == "rent" && !m_startDate.isEmpty() && m_endDate < m_startDate) {
+            if (m_contractType == ContractType::Rent && !m_startDate.isEmpty() && m_endDate < m_startDate) {
                 throw InvalidDateRangeException(m_startDate.toString(), m_endDate.toString());
             }
         } catch (const InvalidDateException& e) {
@@ -61,11 +62,13 @@ void Contract::setEndDateFromString(const std::string& endDate) {
     }
 }
 
-void Contract::setContractType(const std::string &contractType) {
-    if(contractType != "sale" && contractType != "rent")
+void Contract::setContractType(const std::string &contractTypeInput) {
+    std::optional<ContractType> contractType = parseContractType(contractTypeInput);
+    if(!contractType)
         throw ValidationException("Contract type must be 'sale' or 'rent'.");
-    m_contractType = contractType;
+    m_contractType = *contractType;
 }
+void Contract::setContractType(ContractType contractType) { m_contractType = contractType; }
 void Contract::setIsActive(bool isActive) { m_isActive = isActive; }
 
 bool Contract::isValid() const {
@@ -77,7 +80,7 @@ bool Contract::isValid() const {
         return false;
     if(!m_endDate.isEmpty() && m_startDate > m_endDate) 
         return false;
-    if(m_contractType != "sale" && m_contractType != "rent") 
+    if(!isKnown(m_contractType))
         return false;
     return true;
 }
@@ -90,7 +93,7 @@ std::ostream& operator<<(std::ostream &os, const Contract &contract) {
        << "\nPrice: " << contract.m_price
        << "\nStart: " << contract.m_startDate
        << "\nEnd: " << contract.m_endDate
-       << "\nType: " << contract.m_contractType
+       << "\nType: " << toString(contract.m_contractType)
        << "\nActive: " << (contract.m_isActive ? "Yes" : "No");
     return os;
 }
@@ -98,8 +101,14 @@ std::ostream& operator<<(std::ostream &os, const Contract &contract) {
 std::istream& operator>>(std::istream &is, Contract &contract) {
     // Order: id, propertyId, clientId, agentId, price, startDate, endDate, contractType, isActive (0/1)
     int active;
+    std::string contractType;
     is >> contract.m_id >> contract.m_propertyId >> contract.m_clientId >> contract.m_agentId
-       >> contract.m_price >> contract.m_startDate >> contract.m_endDate >> contract.m_contractType >> active;
+       >> contract.m_price >> contract.m_startDate >> contract.m_endDate >> contractType >> active;
     contract.m_isActive = (active != 0);
+    std::optional<ContractType> parsedType = parseContractType(contractType);
+    if (!parsedType)
+        is.setstate(std::ios::failbit);
+    else
+        contract.m_contractType = *parsedType;
     return is;
 }
@@ -3,8 +3,10 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include "Exceptions.h"
 #include "Date.h"
+#include "EntityTypes.h"
 
 class Contract {
 public:
@@ -19,9 +21,10 @@ public:
     int getClientId() const;
     int getAgentId() const;
     double getPrice() const;
-    Date getStartDate() const;
-    Date getEndDate() const;
-    std::string getContractType() const;
+    const Date &getStartDate() const;
+    const Date &getEndDate() const;
+    std::string_view getContractType() const;
+    ContractType getContractTypeEnum() const;
     bool getIsActive() const;
 
     // Setters
@@ -33,6 +36,7 @@ public:
     void setStartDate(const Date &startDate);
     void setEndDate(const Date &endDate);
     void setContractType(const std::string &contractType); // Must be "sale" or "rent"
+    void setContractType(ContractType contractType);
     void setIsActive(bool isActive);
 
     // For backward compatibility (used in file operations)
@@ -56,7 +60,7 @@ private:
     double m_price;
     Date m_startDate;
     Date m_endDate;
-    std::string m_contractType; // "sale" or "rent"
+    ContractType m_contractType;
     bool m_isActive;
 };
 
@@ -1,118 +1,112 @@
 #include "Date.h"
-#include <iomanip>
-#include <sstream>
 #include <ctime>
 
-Date::Date() : m_isEmpty(false) {
+Date::Date() {
     // Get current date
+    // Reentrant localtime: entities (and so dates) are built on several
+    // loader threads at once.
     std::time_t t = std::time(nullptr);
-    std::tm* now = std::localtime(&t);
-    
-    m_year = now->tm_year + 1900;
-    m_month = now->tm_mon + 1;
-    m_day = now->tm_mday;
-}
-
-Date::Date(int year, int month, int day)
-    : m_year(year), m_month(month), m_day(day), m_isEmpty(false) {
-    validate();
-}
-
-Date::Date(const std::string& dateStr) : m_isEmpty(false) {
-    if (dateStr.empty()) {
-        m_isEmpty = true;
-        m_year = 0;
-        m_month = 0;
-        m_day = 0;
-        return;
-    }
-    
-   try {
-        if (dateStr.find('-') != std::string::npos) {
-            // Parse "YYYY-MM-DD" format with hyphens
-            std::stringstream ss(dateStr);
-            char delimiter;
-            ss >> m_year >> delimiter >> m_month >> delimiter >> m_day;
-            
-            if (ss.fail()) {
-                throw std::invalid_argument("Invalid date format");
-            }
-        } else if (dateStr.length() == 8) {
-            // Parse as YYYYMMDD
-            m_year = std::stoi(dateStr.substr(0, 4));
-            m_month = std::stoi(dateStr.substr(4, 2));
-            m_day = std::stoi(dateStr.substr(6, 2));
-        } else {
-            throw std::invalid_argument("Invalid date format");
-        }
-        
-        validate();
-    } catch (const std::exception&) {
-        throw InvalidDateException(dateStr);
+    std::tm now{};
+#ifdef _WIN32
+    localtime_s(&now, &t);
+#else
+    localtime_r(&t, &now);
+#endif
+    m_days = daysFromCivil(now.tm_year + 1900, now.tm_mon + 1, now.tm_mday);
+}
+
+Date::Date(int year, int month, int day) : m_days(daysFromCivil(year, month, day)) {
+    if (!isValid(year, month, day)) {
+        throw InvalidDateException(std::to_string(year) + "-" + std::to_string(month) + "-" + std::to_string(day));
     }
 }
 
-std::string Date::toString() const {
-    if (m_isEmpty) {
-        return "";
+Date::Date(const std::string& dateStr) : m_days(kEmptyDays) {
+    std::optional<Date> parsed = tryParse(dateStr);
+    if (!parsed) {
+        throw InvalidDateException(dateStr);
     }
-    
-    std::stringstream ss;
-    ss << std::setw(4) << std::setfill('0') << m_year << "-"
-       << std::setw(2) << std::setfill('0') << m_month << "-"
-       << std::setw(2) << std::setfill('0') << m_day;
-    return ss.str();
+    *this = *parsed;
 }
 
-bool Date::isValid(int year, int month, int day) {
-    if (year < 1900 || year > 2100) return false;
-    if (month < 1 || month > 12) return false;
-    if (day < 1 || day > daysInMonth(year, month)) return false;
-    return true;
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
 }
 
-void Date::validate() const {
-    if (m_isEmpty) return;
-    
-    if (!isValid(m_year, m_month, m_day)) {
-        throw InvalidDateException(toString());
+// Reads the digits in [first, last); false on an empty field, a non-digit,
+// or more than four digits.
+static bool readNumber(const char* first, const char* last, int& value) {
+    if (first == last || last - first > 4) return false;
+    value = 0;
+    for (; first != last; ++first) {
+        if (!isDigit(*first)) return false;
+        value = value * 10 + (*first - '0');
     }
+    return true;
 }
 
-bool Date::operator==(const Date& other) const {
-    if (m_isEmpty && other.m_isEmpty) return true;
-    if (m_isEmpty || other.m_isEmpty) return false;
-    
-    return m_year == other.m_year && m_month == other.m_month && m_day == other.m_day;
+// Fixed-width field: `width` digits starting at `first`.
+static bool readDigits(const char* first, int width, int& value) {
+    return readNumber(first, first + width, value);
 }
 
-bool Date::operator!=(const Date& other) const {
-    return !(*this == other);
-}
+std::optional<Date> Date::tryParse(std::string_view dateStr) {
+    if (dateStr.empty()) {
+        return emptyDate();
+    }
 
-bool Date::operator<(const Date& other) const {
-    if (m_isEmpty) return !other.m_isEmpty; // Empty dates are "less than" non-empty dates
-    if (other.m_isEmpty) return false;
-    
-    if (m_year != other.m_year) return m_year < other.m_year;
-    if (m_month != other.m_month) return m_month < other.m_month;
-    return m_day < other.m_day;
-}
+    const char* begin = dateStr.data();
+    const char* end = begin + dateStr.size();
+    int year = 0, month = 0, day = 0;
+    bool parsed = false;
+    if (dateStr.size() == 10 && begin[4] == '-' && begin[7] == '-') {
+        // "YYYY-MM-DD", the format we write
+        parsed = readDigits(begin, 4, year) && readDigits(begin + 5, 2, month) && readDigits(begin + 8, 2, day);
+    } else if (dateStr.size() == 8 && dateStr.find('-') == std::string_view::npos) {
+        parsed = readDigits(begin, 4, year) && readDigits(begin + 4, 2, month) && readDigits(begin + 6, 2, day);
+    } else {
+        // Hand-typed "YYYY-M-D" with single-digit fields
+        const char* firstDash = std::char_traits<char>::find(begin, dateStr.size(), '-');
+        const char* secondDash = firstDash ? std::char_traits<char>::find(firstDash + 1, end - firstDash - 1, '-') : nullptr;
+        parsed = secondDash &&
+                 readNumber(begin, firstDash, year) &&
+                 readNumber(firstDash + 1, secondDash, month) &&
+                 readNumber(secondDash + 1, end, day);
+    }
 
-bool Date::operator<=(const Date& other) const {
-    return *this < other || *this == other;
+    if (!parsed || !isValid(year, month, day)) {
+        return std::nullopt;
+    }
+    return fromDays(daysFromCivil(year, month, day));
 }
 
-bool Date::operator>(const Date& other) const {
-    return !(*this <= other);
+std::size_t Date::format(char* buffer) const {
+    if (isEmpty()) {
+        return 0;
+    }
+    Civil civil = toCivil();
+    int year = civil.year;
+    buffer[3] = static_cast<char>('0' + year % 10); year /= 10;
+    buffer[2] = static_cast<char>('0' + year % 10); year /= 10;
+    buffer[1] = static_cast<char>('0' + year % 10); year /= 10;
+    buffer[0] = static_cast<char>('0' + year % 10);
+    buffer[4] = '-';
+    buffer[5] = static_cast<char>('0' + civil.month / 10);
+    buffer[6] = static_cast<char>('0' + civil.month % 10);
+    buffer[7] = '-';
+    buffer[8] = static_cast<char>('0' + civil.day / 10);
+    buffer[9] = static_cast<char>('0' + civil.day % 10);
+    return kFormattedSize;
 }
 
-bool Date::operator>=(const Date& other) const {
-    return !(*this < other);
+std::string Date::toString() const {
+    char buffer[kFormattedSize];
+    return std::string(buffer, format(buffer));
 }
 
 std::ostream& operator<<(std::ostream& os, const Date& date) {
-    os << date.toString();
+    char buffer[Date::kFormattedSize];
+    os.write(buffer, static_cast<std::streamsize>(date.format(buffer)));
     return os;
 }
 
@@ -127,34 +121,9 @@ std::istream& operator>>(std::istream& is, Date& date) {
     return is;
 }
 
-bool Date::isLeapYear(int year) {
-    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
-}
-
-int Date::daysInMonth(int year, int month) {
-    static const int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    if (month == 2 && isLeapYear(year)) {
-        return 29;
-    }
-    return days[month - 1];
-}
-
 Date Date::fromString(const std::string& dateStr) {
     if (dateStr.empty()) {
         return emptyDate();
     }
     return Date(dateStr);
 }
-
-bool Date::isEmpty() const {
-    return m_isEmpty;
-}
-
-Date Date::emptyDate() {
-    Date date;
-    date.m_isEmpty = true;
-    date.m_year = 0;
-    date.m_month = 0;
-    date.m_day = 0;
-    return date;
-}
\ No newline at end of file
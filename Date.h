@@ -1,60 +1,141 @@
 #ifndef DATE_H
 #define DATE_H
 
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <optional>
 #include <iostream>
 #include "Exceptions.h"
 
+// A calendar date stored as a day number (days since 1970-01-01), so
+// comparisons are a single integer compare and day arithmetic is addition.
+// The empty date is a sentinel below every real day.
 class Date {
 public:
+    struct Civil {
+        int year;
+        int month;
+        int day;
+    };
+
     // Constructors
     Date(); // Current date
     Date(int year, int month, int day);
     Date(const std::string& dateStr); // Format: "YYYY-MM-DD"
-    
+
     // Getters
-    int getYear() const { return m_year; }
-    int getMonth() const { return m_month; }
-    int getDay() const { return m_day; }
-    
+    int getYear() const { return toCivil().year; }
+    int getMonth() const { return toCivil().month; }
+    int getDay() const { return toCivil().day; }
+    constexpr Civil toCivil() const {
+        return m_days == kEmptyDays ? Civil{0, 0, 0} : civilFromDays(m_days);
+    }
+    constexpr std::int32_t toDays() const { return m_days; }
+    static constexpr Date fromDays(std::int32_t days) { return Date(days, DayNumber{}); }
+
     // Convert to string in "YYYY-MM-DD" format
     std::string toString() const;
-    
+    // Writes "YYYY-MM-DD" (no terminator) into `buffer`, which must hold
+    // kFormattedSize chars; returns the length written (0 for an empty date).
+    static constexpr std::size_t kFormattedSize = 10;
+    std::size_t format(char* buffer) const;
+
     // Check if date is valid
-    static bool isValid(int year, int month, int day);
-    
+    static constexpr bool isValid(int year, int month, int day) {
+        return year >= 1900 && year <= 2100 &&
+               month >= 1 && month <= 12 &&
+               day >= 1 && day <= daysInMonth(year, month);
+    }
+
     // Compare dates
-    bool operator==(const Date& other) const;
-    bool operator!=(const Date& other) const;
-    bool operator<(const Date& other) const;
-    bool operator<=(const Date& other) const;
-    bool operator>(const Date& other) const;
-    bool operator>=(const Date& other) const;
-    
+    constexpr bool operator==(const Date& other) const { return m_days == other.m_days; }
+    constexpr bool operator!=(const Date& other) const { return m_days != other.m_days; }
+    constexpr bool operator<(const Date& other) const { return m_days < other.m_days; }
+    constexpr bool operator<=(const Date& other) const { return m_days <= other.m_days; }
+    constexpr bool operator>(const Date& other) const { return m_days > other.m_days; }
+    constexpr bool operator>=(const Date& other) const { return m_days >= other.m_days; }
+
+    // Day arithmetic; an empty date stays empty.
+    constexpr Date addDays(int days) const {
+        return m_days == kEmptyDays ? *this : fromDays(m_days + days);
+    }
+    // Same day of month `months` later, clamped to the end of shorter
+    // months (Jan 31 + 1 month = Feb 28/29).
+    constexpr Date addMonths(int months) const {
+        if (m_days == kEmptyDays) return *this;
+        Civil civil = civilFromDays(m_days);
+        int monthIndex = civil.year * 12 + (civil.month - 1) + months;
+        int year = monthIndex / 12;
+        int month = monthIndex % 12 + 1;
+        int lastDay = daysInMonth(year, month);
+        return fromDays(daysFromCivil(year, month, civil.day < lastDay ? civil.day : lastDay));
+    }
+    // Days from this date to `other` (negative if `other` is earlier);
+    // 0 if either date is empty.
+    constexpr int daysUntil(const Date& other) const {
+        return m_days == kEmptyDays || other.m_days == kEmptyDays ? 0 : other.m_days - m_days;
+    }
+
     // Stream operators
     friend std::ostream& operator<<(std::ostream& os, const Date& date);
     friend std::istream& operator>>(std::istream& is, Date& date);
-    
+
     // Static methods for validation
-    static bool isLeapYear(int year);
-    static int daysInMonth(int year, int month);
-    
+    static constexpr bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+    }
+    static constexpr int daysInMonth(int year, int month) {
+        constexpr int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+    }
+
+    // Proleptic Gregorian conversions between a civil date and its day
+    // number (H. Hinnant's days_from_civil / civil_from_days).
+    static constexpr std::int32_t daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const int yearOfEra = year - era * 400;
+        const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+    static constexpr Civil civilFromDays(std::int32_t days) {
+        days += 719468;
+        const int era = (days >= 0 ? days : days - 146096) / 146097;
+        const int dayOfEra = days - era * 146097;
+        const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int shiftedMonth = (5 * dayOfYear + 2) / 153;
+        const int day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+        const int month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+        return Civil{yearOfEra + era * 400 + (month <= 2), month, day};
+    }
+
     // Parse string to Date
     static Date fromString(const std::string& dateStr);
-    
+    // Non-throwing parse of "YYYY-MM-DD" or "YYYYMMDD"; "" gives an empty
+    // date, malformed or out-of-range input gives std::nullopt.
+    static std::optional<Date> tryParse(std::string_view dateStr);
+
     // Check if date is empty (for optional dates)
-    bool isEmpty() const;
-    
+    constexpr bool isEmpty() const { return m_days == kEmptyDays; }
+
     // Create an empty date
-    static Date emptyDate();
+    static constexpr Date emptyDate() { return fromDays(kEmptyDays); }
 
 private:
-    int m_year;
-    int m_month;
-    int m_day;
-    bool m_isEmpty;
-    
-    void validate() const;
+    static constexpr std::int32_t kEmptyDays = std::numeric_limits<std::int32_t>::min();
+
+    struct DayNumber {};
+    constexpr Date(std::int32_t days, DayNumber) : m_days(days) {}
+
+    std::int32_t m_days;
 };
 
-#endif
\ No newline at end of file
+static_assert(Date::daysFromCivil(1970, 1, 1) == 0, "day numbers start at the Unix epoch");
+static_assert(Date::civilFromDays(Date::daysFromCivil(2024, 2, 29)).day == 29, "civil round trip");
+static_assert(Date::emptyDate() < Date::fromDays(Date::daysFromCivil(1900, 1, 1)), "empty sorts first");
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef ENTITYTYPES_H
+#define ENTITYTYPES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// Small categorical values stored as one-byte enums. The name tables below
+// are the single source of truth for their CSV/console spelling; parsing and
+// printing are table lookups that can run at compile time.
+
+enum class PropertyType : std::uint8_t { Land, House, Apartment };
+enum class ListingType : std::uint8_t { Sale, Rent };
+enum class ContractType : std::uint8_t { Sale, Rent };
+enum class BudgetType : std::uint8_t { Rent, Buy };
+
+namespace EntityTypes {
+
+constexpr std::array<std::string_view, 3> propertyTypeNames = {"land", "house", "apartment"};
+constexpr std::array<std::string_view, 2> listingTypeNames = {"sale", "rent"};
+constexpr std::array<std::string_view, 2> contractTypeNames = {"sale", "rent"};
+constexpr std::array<std::string_view, 2> budgetTypeNames = {"rent", "buy"};
+
+constexpr char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (toLower(a[i]) != toLower(b[i])) return false;
+    }
+    return true;
+}
+
+template <typename Enum, std::size_t N>
+constexpr std::optional<Enum> lookup(const std::array<std::string_view, N> &names, std::string_view text,
+                                     bool ignoreCase) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (ignoreCase ? equalsIgnoreCase(names[i], text) : names[i] == text)
+            return static_cast<Enum>(i);
+    }
+    return std::nullopt;
+}
+
+template <typename Enum, std::size_t N>
+constexpr bool inRange(const std::array<std::string_view, N> &, Enum value) {
+    return static_cast<std::size_t>(value) < N;
+}
+
+} // namespace EntityTypes
+
+// Property types have always been accepted in any letter case.
+constexpr std::optional<PropertyType> parsePropertyType(std::string_view text) {
+    return EntityTypes::lookup<PropertyType>(EntityTypes::propertyTypeNames, text, true);
+}
+constexpr std::optional<ListingType> parseListingType(std::string_view text) {
+    return EntityTypes::lookup<ListingType>(EntityTypes::listingTypeNames, text, false);
+}
+constexpr std::optional<ContractType> parseContractType(std::string_view text) {
+    return EntityTypes::lookup<ContractType>(EntityTypes::contractTypeNames, text, false);
+}
+constexpr std::optional<BudgetType> parseBudgetType(std::string_view text) {
+    return EntityTypes::lookup<BudgetType>(EntityTypes::budgetTypeNames, text, false);
+}
+
+constexpr std::string_view toString(PropertyType type) {
+    return EntityTypes::propertyTypeNames[static_cast<std::size_t>(type)];
+}
+constexpr std::string_view toString(ListingType type) {
+    return EntityTypes::listingTypeNames[static_cast<std::size_t>(type)];
+}
+constexpr std::string_view toString(ContractType type) {
+    return EntityTypes::contractTypeNames[static_cast<std::size_t>(type)];
+}
+constexpr std::string_view toString(BudgetType type) {
+    return EntityTypes::budgetTypeNames[static_cast<std::size_t>(type)];
+}
+
+constexpr bool isKnown(PropertyType type) { return EntityTypes::inRange(EntityTypes::propertyTypeNames, type); }
+constexpr bool isKnown(ListingType type) { return EntityTypes::inRange(EntityTypes::listingTypeNames, type); }
+constexpr bool isKnown(ContractType type) { return EntityTypes::inRange(EntityTypes::contractTypeNames, type); }
+constexpr bool isKnown(BudgetType type) { return EntityTypes::inRange(EntityTypes::budgetTypeNames, type); }
+
+static_assert(parsePropertyType("House") == PropertyType::House, "property type table out of sync");
+static_assert(toString(BudgetType::Buy) == "buy", "budget type table out of sync");
+
+#endif // ENTITYTYPES_H
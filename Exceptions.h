@@ -72,6 +72,19 @@ private:
     std::string phone;
 };
 
+class DuplicateValueException : public ValidationException {
+public:
+    DuplicateValueException(const std::string& field, const std::string& value) 
+        : ValidationException("Duplicate " + field + ": " + value), field(field), value(value) {}
+    
+    std::string getField() const { return field; }
+    std::string getValue() const { return value; }
+
+private:
+    std::string field;
+    std::string value;
+};
+
 class InvalidDateException : public ValidationException {
 public:
     InvalidDateException(const std::string& date) 
@@ -0,0 +1,40 @@
+#include "FileUtil.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool syncFile(std::FILE *file) {
+    if (std::fflush(file) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool syncPath(const std::string &path) {
+    // Opened for append so _commit is allowed on Windows; nothing is written.
+    std::FILE *file = std::fopen(path.c_str(), "ab");
+    if (!file)
+        return false;
+    bool synced = syncFile(file);
+    return std::fclose(file) == 0 && synced;
+}
+
+bool syncDirectory(const std::string &directory) {
+#ifdef _WIN32
+    (void)directory;
+    return true;
+#else
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    bool synced = fsync(fd) == 0;
+    return close(fd) == 0 && synced;
+#endif
+}
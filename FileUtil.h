@@ -0,0 +1,19 @@
+#ifndef FILEUTIL_H
+#define FILEUTIL_H
+
+#include <cstdio>
+#include <string>
+
+// Flushes the stdio buffer of `file` and asks the OS to write the file's
+// data to stable storage (fsync, or _commit on Windows). Returns false if
+// either step fails.
+bool syncFile(std::FILE *file);
+
+// syncFile for a file that has already been written and closed.
+bool syncPath(const std::string &path);
+
+// Makes renames and creations inside `directory` durable. POSIX only needs
+// this for the directory entry; on Windows it is a no-op.
+bool syncDirectory(const std::string &directory);
+
+#endif // FILEUTIL_H
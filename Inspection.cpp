@@ -1,27 +1,91 @@
 #include "Inspection.h"
-#include <sstream>
 
-Inspection::Inspection() : m_id(-1), m_agentId(-1), m_propertyId(-1) {}
+static constexpr std::int32_t kMinutesPerDay = 24 * 60;
 
-Inspection::Inspection(int id, int agentId, int propertyId, const string &dateTime, const string &notes)
-    : m_id(id), m_agentId(agentId), m_propertyId(propertyId), m_dateTime(dateTime), m_notes(notes)
-{}
+Inspection::Inspection()
+    : m_id(-1), m_agentId(-1), m_propertyId(-1), m_startMinute(kUnscheduled),
+      m_durationMinutes(kDefaultDurationMinutes) {}
+
+Inspection::Inspection(int id, int agentId, int propertyId, const string &dateTime, const string &notes,
+                       int durationMinutes)
+    : m_id(id), m_agentId(agentId), m_propertyId(propertyId), m_startMinute(kUnscheduled),
+      m_durationMinutes(durationMinutes), m_notes(notes)
+{
+    setDateTime(dateTime);
+}
 
 int Inspection::getId() const { return m_id; }
 int Inspection::getAgentId() const { return m_agentId; }
 int Inspection::getPropertyId() const { return m_propertyId; }
-string Inspection::getDateTime() const { return m_dateTime; }
-string Inspection::getNotes() const { return m_notes; }
+string Inspection::getDateTime() const { return formatDateTime(m_startMinute); }
+std::int32_t Inspection::getStartMinute() const { return m_startMinute; }
+std::int32_t Inspection::getEndMinute() const { return m_startMinute + m_durationMinutes; }
+int Inspection::getDurationMinutes() const { return m_durationMinutes; }
+const string &Inspection::getNotes() const { return m_notes; }
 
 void Inspection::setId(int id) { m_id = id; }
 void Inspection::setAgentId(int agentId) { m_agentId = agentId; }
 void Inspection::setPropertyId(int propertyId) { m_propertyId = propertyId; }
-void Inspection::setDateTime(const string &dateTime) { m_dateTime = dateTime; }
+void Inspection::setDateTime(const string &dateTime) {
+    std::optional<std::int32_t> minute = parseDateTime(dateTime);
+    if(!minute)
+        throw ValidationException("Inspection time must be 'YYYY-MM-DD HH:MM': " + dateTime);
+    m_startMinute = *minute;
+}
+void Inspection::setStartMinute(std::int32_t startMinute) { m_startMinute = startMinute; }
+void Inspection::setDurationMinutes(int durationMinutes) { m_durationMinutes = durationMinutes; }
 void Inspection::setNotes(const string &notes) { m_notes = notes; }
 
+static bool readTwoDigits(const char *text, int &value) {
+    if(text[0] < '0' || text[0] > '9' || text[1] < '0' || text[1] > '9') return false;
+    value = (text[0] - '0') * 10 + (text[1] - '0');
+    return true;
+}
+
+std::optional<std::int32_t> Inspection::parseDateTime(std::string_view dateTime) {
+    // "YYYY-MM-DD HH:MM" with an optional ":SS" that is ignored
+    if(dateTime.size() != 16 && dateTime.size() != 19)
+        return std::nullopt;
+    if(dateTime[10] != ' ' && dateTime[10] != 'T')
+        return std::nullopt;
+    std::optional<Date> date = Date::tryParse(dateTime.substr(0, 10));
+    if(!date || date->isEmpty())
+        return std::nullopt;
+    int hour = 0, minute = 0, second = 0;
+    if(!readTwoDigits(dateTime.data() + 11, hour) || dateTime[13] != ':' ||
+       !readTwoDigits(dateTime.data() + 14, minute))
+        return std::nullopt;
+    if(dateTime.size() == 19 && (dateTime[16] != ':' || !readTwoDigits(dateTime.data() + 17, second)))
+        return std::nullopt;
+    if(hour > 23 || minute > 59 || second > 59)
+        return std::nullopt;
+    return date->toDays() * kMinutesPerDay + hour * 60 + minute;
+}
+
+string Inspection::formatDateTime(std::int32_t minute) {
+    if(minute == kUnscheduled)
+        return "";
+    std::int32_t days = minute / kMinutesPerDay;
+    std::int32_t minuteOfDay = minute % kMinutesPerDay;
+    if(minuteOfDay < 0) {
+        minuteOfDay += kMinutesPerDay;
+        --days;
+    }
+    char buffer[Date::kFormattedSize + 6];
+    std::size_t length = Date::fromDays(days).format(buffer);
+    buffer[length++] = ' ';
+    buffer[length++] = static_cast<char>('0' + minuteOfDay / 600);
+    buffer[length++] = static_cast<char>('0' + minuteOfDay / 60 % 10);
+    buffer[length++] = ':';
+    buffer[length++] = static_cast<char>('0' + minuteOfDay % 60 / 10);
+    buffer[length++] = static_cast<char>('0' + minuteOfDay % 10);
+    return string(buffer, length);
+}
+
 bool Inspection::isValid() const {
     if(m_agentId < 0 || m_propertyId < 0) return false;
-    if(m_dateTime.empty()) return false;
+    if(m_startMinute == kUnscheduled) return false;
+    if(m_durationMinutes <= 0 || m_durationMinutes > kMinutesPerDay) return false;
     return true;
 }
 
@@ -29,13 +93,21 @@ ostream& operator<<(ostream &os, const Inspection &inspection) {
     os << "ID: " << inspection.m_id
        << "\nAgent ID: " << inspection.m_agentId
        << "\nProperty ID: " << inspection.m_propertyId
-       << "\nDate/Time: " << inspection.m_dateTime
+       << "\nDate/Time: " << inspection.getDateTime()
+       << "\nDuration: " << inspection.m_durationMinutes << " min"
        << "\nNotes: " << inspection.m_notes;
     return os;
 }
 
 istream& operator>>(istream &is, Inspection &inspection) {
+    string date, time;
     is >> inspection.m_id >> inspection.m_agentId >> inspection.m_propertyId;
-    is >> inspection.m_dateTime >> inspection.m_notes;
+    is >> date >> time >> inspection.m_notes;
+    std::optional<std::int32_t> minute = Inspection::parseDateTime(date + " " + time);
+    if(minute) {
+        inspection.m_startMinute = *minute;
+    } else {
+        is.setstate(std::ios::failbit);
+    }
     return is;
 }
@@ -1,31 +1,51 @@
 #ifndef INSPECTION_H
 #define INSPECTION_H
 
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include "Exceptions.h"
+#include "Date.h"
 using std::string;
 using std::ostream;
 using std::istream;
 
 class Inspection {
 public:
+    // Minutes are counted from 1970-01-01 00:00, matching Date::toDays().
+    static constexpr std::int32_t kUnscheduled = INT32_MIN;
+    static constexpr int kDefaultDurationMinutes = 30;
+
     Inspection();
-    Inspection(int id, int agentId, int propertyId, const string &dateTime, const string &notes);
+    Inspection(int id, int agentId, int propertyId, const string &dateTime, const string &notes,
+               int durationMinutes = kDefaultDurationMinutes);
 
     // Getters
     int getId() const;
     int getAgentId() const;
     int getPropertyId() const;
-    string getDateTime() const;
-    string getNotes() const;
+    string getDateTime() const; // "YYYY-MM-DD HH:MM", or "" if unscheduled
+    std::int32_t getStartMinute() const;
+    std::int32_t getEndMinute() const; // exclusive
+    int getDurationMinutes() const;
+    const string &getNotes() const;
 
     // Setters
     void setId(int id);
     void setAgentId(int agentId);
     void setPropertyId(int propertyId);
-    void setDateTime(const string &dateTime);
+    void setDateTime(const string &dateTime); // throws ValidationException if unparseable
+    void setStartMinute(std::int32_t startMinute);
+    void setDurationMinutes(int durationMinutes);
     void setNotes(const string &notes);
 
+    // "YYYY-MM-DD HH:MM" (optionally ":SS", or 'T' as separator) to minutes
+    // since the epoch; std::nullopt if malformed.
+    static std::optional<std::int32_t> parseDateTime(std::string_view dateTime);
+    static string formatDateTime(std::int32_t minute);
+
     // Validation
     bool isValid() const;
 
@@ -37,7 +57,8 @@ private:
     int m_id;           // Use -1 if unsaved.
     int m_agentId;
     int m_propertyId;
-    string m_dateTime;  // Expected format "YYYY-MM-DD HH:MM:SS" (as string)
+    std::int32_t m_startMinute;
+    int m_durationMinutes;
     string m_notes;
 };
 
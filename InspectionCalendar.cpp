@@ -0,0 +1,38 @@
+#include "InspectionCalendar.h"
+#include <iterator>
+
+InspectionCalendar::const_iterator InspectionCalendar::lastStartingBefore(std::int32_t minute) const {
+    auto next = m_ranges.lower_bound(minute);
+    return next == m_ranges.begin() ? m_ranges.end() : std::prev(next);
+}
+
+int InspectionCalendar::conflictWith(std::int32_t start, std::int32_t end) const {
+    auto previous = lastStartingBefore(end);
+    if(previous == m_ranges.end() || previous->second.first <= start)
+        return -1;
+    return previous->second.second;
+}
+
+std::int32_t InspectionCalendar::busyUntil(std::int32_t start, std::int32_t end) const {
+    auto previous = lastStartingBefore(end);
+    if(previous == m_ranges.end() || previous->second.first <= start)
+        return start;
+    return previous->second.first;
+}
+
+bool InspectionCalendar::book(int inspectionId, std::int32_t start, std::int32_t end) {
+    if(conflictWith(start, end) != -1)
+        return false;
+    m_ranges.emplace(start, std::make_pair(end, inspectionId));
+    return true;
+}
+
+void InspectionCalendar::release(int inspectionId, std::int32_t start) {
+    auto found = m_ranges.find(start);
+    if(found != m_ranges.end() && found->second.second == inspectionId)
+        m_ranges.erase(found);
+}
+
+bool InspectionCalendar::empty() const {
+    return m_ranges.empty();
+}
@@ -0,0 +1,43 @@
+#ifndef INSPECTIONCALENDAR_H
+#define INSPECTIONCALENDAR_H
+
+#include <cstdint>
+#include <map>
+
+// Grid used when suggesting inspection slots. Minutes of day are counted
+// from midnight; a slot must end by dayEndMinute.
+struct SlotOptions {
+    int slotMinutes = 30;
+    int dayStartMinute = 9 * 60;
+    int dayEndMinute = 18 * 60;
+    int horizonDays = 30; // how far ahead to search
+};
+
+// Busy minutes of one agent or one property: half-open [start, end)
+// ranges keyed by start, each owned by an inspection id. Ranges never
+// overlap, so the range starting just before a requested end is the only
+// one that can clash with it, and checks are O(log n).
+class InspectionCalendar {
+public:
+    // Inspection id of a range overlapping [start, end), or -1.
+    int conflictWith(std::int32_t start, std::int32_t end) const;
+    // End of the range overlapping [start, end), or `start` if it is free.
+    std::int32_t busyUntil(std::int32_t start, std::int32_t end) const;
+    // Records the range unless it conflicts; returns false if it does.
+    bool book(int inspectionId, std::int32_t start, std::int32_t end);
+    // Drops the range at `start` if it belongs to `inspectionId`.
+    void release(int inspectionId, std::int32_t start);
+    bool empty() const;
+
+    using const_iterator = std::map<std::int32_t, std::pair<std::int32_t, int>>::const_iterator;
+    const_iterator begin() const { return m_ranges.begin(); }
+    const_iterator end() const { return m_ranges.end(); }
+
+private:
+    // start -> (end, inspection id)
+    std::map<std::int32_t, std::pair<std::int32_t, int>> m_ranges;
+
+    const_iterator lastStartingBefore(std::int32_t minute) const;
+};
+
+#endif // INSPECTIONCALENDAR_H
@@ -0,0 +1,192 @@
+#include "IntervalIndex.h"
+#include <algorithm>
+#include <limits>
+
+// Deterministic heap priority from the id (a 32-bit integer mix), so the
+// tree shape does not depend on insertion order.
+static std::uint32_t priorityOf(int id) {
+    std::uint32_t x = static_cast<std::uint32_t>(id);
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+void IntervalIndex::insert(int id, const Date &start, const Date &end) {
+    erase(id);
+    Node node;
+    node.start = startKey(start);
+    node.end = endKey(end);
+    node.maxEnd = node.end;
+    node.id = id;
+    node.priority = priorityOf(id);
+    std::int32_t index;
+    if(!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+        m_nodes[index] = node;
+    } else {
+        index = static_cast<std::int32_t>(m_nodes.size());
+        m_nodes.push_back(node);
+    }
+    m_byId.emplace(id, index);
+    m_root = insertNode(m_root, index);
+}
+
+void IntervalIndex::erase(int id) {
+    auto found = m_byId.find(id);
+    if(found == m_byId.end())
+        return;
+    m_root = eraseNode(m_root, found->second);
+    m_free.push_back(found->second);
+    m_byId.erase(found);
+}
+
+void IntervalIndex::clear() {
+    m_nodes.clear();
+    m_free.clear();
+    m_byId.clear();
+    m_root = kNil;
+}
+
+void IntervalIndex::reserve(std::size_t n) {
+    m_nodes.reserve(n);
+    m_byId.reserve(n);
+}
+
+std::size_t IntervalIndex::size() const {
+    return m_byId.size();
+}
+
+std::vector<int> IntervalIndex::containing(const Date &day) const {
+    return overlapping(day, day);
+}
+
+std::vector<int> IntervalIndex::overlapping(const Date &from, const Date &to) const {
+    std::vector<int> result;
+    if(from.isEmpty() || to.isEmpty() || to < from)
+        return result;
+    collectOverlapping(m_root, from.toDays(), to.toDays(), result);
+    return result;
+}
+
+std::vector<int> IntervalIndex::startingBetween(const Date &from, const Date &to) const {
+    std::vector<int> result;
+    if(from.isEmpty() || to.isEmpty() || to < from)
+        return result;
+    collectStarting(m_root, from.toDays(), to.toDays(), result);
+    return result;
+}
+
+// An empty start has no lower bound and an empty end no upper bound.
+std::int32_t IntervalIndex::startKey(const Date &start) {
+    return start.isEmpty() ? std::numeric_limits<std::int32_t>::min() : start.toDays();
+}
+
+std::int32_t IntervalIndex::endKey(const Date &end) {
+    return end.isEmpty() ? std::numeric_limits<std::int32_t>::max() : end.toDays();
+}
+
+bool IntervalIndex::before(std::int32_t a, std::int32_t b) const {
+    const Node &x = m_nodes[a];
+    const Node &y = m_nodes[b];
+    return x.start != y.start ? x.start < y.start : x.id < y.id;
+}
+
+void IntervalIndex::update(std::int32_t node) {
+    Node &n = m_nodes[node];
+    n.maxEnd = n.end;
+    if(n.left != kNil) n.maxEnd = std::max(n.maxEnd, m_nodes[n.left].maxEnd);
+    if(n.right != kNil) n.maxEnd = std::max(n.maxEnd, m_nodes[n.right].maxEnd);
+}
+
+// Splits the subtree at `node` into the nodes ordered before `pivot` and
+// the rest.
+void IntervalIndex::split(std::int32_t node, std::int32_t pivot, std::int32_t &left, std::int32_t &right) {
+    if(node == kNil) {
+        left = right = kNil;
+        return;
+    }
+    if(before(node, pivot)) {
+        split(m_nodes[node].right, pivot, m_nodes[node].right, right);
+        left = node;
+    } else {
+        split(m_nodes[node].left, pivot, left, m_nodes[node].left);
+        right = node;
+    }
+    update(node);
+}
+
+// Joins two subtrees where every node of `left` is ordered before `right`.
+std::int32_t IntervalIndex::merge(std::int32_t left, std::int32_t right) {
+    if(left == kNil) return right;
+    if(right == kNil) return left;
+    if(m_nodes[left].priority > m_nodes[right].priority) {
+        m_nodes[left].right = merge(m_nodes[left].right, right);
+        update(left);
+        return left;
+    }
+    m_nodes[right].left = merge(left, m_nodes[right].left);
+    update(right);
+    return right;
+}
+
+std::int32_t IntervalIndex::insertNode(std::int32_t root, std::int32_t node) {
+    if(root == kNil)
+        return node;
+    if(m_nodes[node].priority > m_nodes[root].priority) {
+        split(root, node, m_nodes[node].left, m_nodes[node].right);
+        update(node);
+        return node;
+    }
+    if(before(node, root))
+        m_nodes[root].left = insertNode(m_nodes[root].left, node);
+    else
+        m_nodes[root].right = insertNode(m_nodes[root].right, node);
+    update(root);
+    return root;
+}
+
+std::int32_t IntervalIndex::eraseNode(std::int32_t root, std::int32_t node) {
+    if(root == node) {
+        std::int32_t joined = merge(m_nodes[node].left, m_nodes[node].right);
+        m_nodes[node].left = m_nodes[node].right = kNil;
+        return joined;
+    }
+    if(before(node, root))
+        m_nodes[root].left = eraseNode(m_nodes[root].left, node);
+    else
+        m_nodes[root].right = eraseNode(m_nodes[root].right, node);
+    update(root);
+    return root;
+}
+
+// In-order walk that skips subtrees ending before `from` and stops at the
+// first start after `to`.
+void IntervalIndex::collectOverlapping(std::int32_t node, std::int32_t from, std::int32_t to,
+                                       std::vector<int> &out) const {
+    if(node == kNil || m_nodes[node].maxEnd < from)
+        return;
+    const Node &n = m_nodes[node];
+    collectOverlapping(n.left, from, to, out);
+    if(n.start > to)
+        return;
+    if(n.end >= from)
+        out.push_back(n.id);
+    collectOverlapping(n.right, from, to, out);
+}
+
+void IntervalIndex::collectStarting(std::int32_t node, std::int32_t from, std::int32_t to,
+                                    std::vector<int> &out) const {
+    if(node == kNil)
+        return;
+    const Node &n = m_nodes[node];
+    if(n.start >= from)
+        collectStarting(n.left, from, to, out);
+    if(n.start >= from && n.start <= to)
+        out.push_back(n.id);
+    if(n.start <= to)
+        collectStarting(n.right, from, to, out);
+}
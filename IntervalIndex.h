@@ -0,0 +1,61 @@
+#ifndef INTERVALINDEX_H
+#define INTERVALINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Date.h"
+
+// Interval tree over closed date ranges [start, end], keyed by entity id.
+// An empty end date means the range is still open. Intervals live in a
+// treap ordered by (start, id) whose nodes also hold the latest end in
+// their subtree, so inserts and erases are O(log n) and stabbing and
+// overlap queries only descend into subtrees that can hold a match.
+// Queries never modify the index, so concurrent readers are safe.
+class IntervalIndex {
+public:
+    void insert(int id, const Date &start, const Date &end); // replaces any existing interval for id
+    void erase(int id);
+    void clear();
+    void reserve(std::size_t n);
+    std::size_t size() const;
+
+    // Ids whose interval contains `day`, in start order.
+    std::vector<int> containing(const Date &day) const;
+    // Ids whose interval shares at least one day with [from, to].
+    std::vector<int> overlapping(const Date &from, const Date &to) const;
+    // Ids whose start lies in [from, to].
+    std::vector<int> startingBetween(const Date &from, const Date &to) const;
+
+private:
+    static constexpr std::int32_t kNil = -1;
+
+    struct Node {
+        std::int32_t start;
+        std::int32_t end;
+        std::int32_t maxEnd; // latest end in this subtree
+        int id;
+        std::uint32_t priority;
+        std::int32_t left = kNil;
+        std::int32_t right = kNil;
+    };
+
+    static std::int32_t startKey(const Date &start);
+    static std::int32_t endKey(const Date &end);
+    bool before(std::int32_t a, std::int32_t b) const; // (start, id) order of two nodes
+    void update(std::int32_t node);
+    void split(std::int32_t node, std::int32_t key, std::int32_t &left, std::int32_t &right);
+    std::int32_t merge(std::int32_t left, std::int32_t right);
+    std::int32_t insertNode(std::int32_t root, std::int32_t node);
+    std::int32_t eraseNode(std::int32_t root, std::int32_t node);
+    void collectOverlapping(std::int32_t node, std::int32_t from, std::int32_t to, std::vector<int> &out) const;
+    void collectStarting(std::int32_t node, std::int32_t from, std::int32_t to, std::vector<int> &out) const;
+
+    std::vector<Node> m_nodes;              // erased slots are reused via m_free
+    std::vector<std::int32_t> m_free;
+    std::unordered_map<int, std::int32_t> m_byId; // entity id -> node
+    std::int32_t m_root = kNil;
+};
+
+#endif // INTERVALINDEX_H
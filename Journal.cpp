@@ -0,0 +1,196 @@
+#include "Journal.h"
+#include "Exceptions.h"
+#include "FileUtil.h"
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 10; // length, crc, op, table
+
+constexpr std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int bit = 0; bit < 8; ++bit)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<std::uint32_t, 256> kCrcTable = makeCrcTable();
+
+// CRC-32 (IEEE), as used by zip and PNG.
+std::uint32_t crc32(std::string_view bytes) {
+    std::uint32_t c = 0xFFFFFFFFu;
+    for (unsigned char byte : bytes)
+        c = kCrcTable[(c ^ byte) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+void putU32(std::string &out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8)
+        out += static_cast<char>((value >> shift) & 0xFF);
+}
+
+std::uint32_t getU32(const char *in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return value;
+}
+
+} // namespace
+
+Journal::Journal(std::string path, SyncPolicy policy, std::chrono::milliseconds syncInterval)
+    : m_path(std::move(path)), m_policy(policy), m_syncInterval(syncInterval) {
+    m_file = std::fopen(m_path.c_str(), "ab");
+    if (!m_file)
+        throw FileOperationException(m_path, "open journal");
+    m_writer = std::thread([this]() { writerLoop(); });
+}
+
+Journal::~Journal() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+    if (m_file)
+        std::fclose(m_file);
+}
+
+void Journal::append(Op op, Table table, std::string_view payload) {
+    std::string record;
+    record.reserve(kHeaderSize + payload.size());
+    putU32(record, static_cast<std::uint32_t>(payload.size()));
+    putU32(record, 0); // crc, filled in below
+    record += static_cast<char>(op);
+    record += static_cast<char>(table);
+    record.append(payload.data(), payload.size());
+    std::uint32_t crc = crc32(std::string_view(record).substr(8));
+    for (int i = 0; i < 4; ++i)
+        record[4 + i] = static_cast<char>((crc >> (8 * i)) & 0xFF);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_pending += record;
+    std::uint64_t target = ++m_appended;
+    m_wake.notify_one();
+    if (m_policy != SyncPolicy::EveryCommit)
+        return;
+    // Every batch is fsynced under this policy, so written means durable.
+    m_drained.wait(lock, [this, target]() { return m_failed || m_written >= target; });
+    throwIfFailed();
+}
+
+void Journal::sync() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::uint64_t target = m_appended;
+    m_syncRequested = true;
+    m_wake.notify_one();
+    m_drained.wait(lock, [this, target]() { return m_failed || (m_written >= target && !m_unsynced); });
+    throwIfFailed();
+}
+
+void Journal::checkpoint() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_drained.wait(lock, [this]() { return !m_writing; });
+    // Whatever is still queued is covered by the saved state as well.
+    m_pending.clear();
+    m_written = m_appended;
+    m_unsynced = false;
+    m_file = m_file ? std::freopen(m_path.c_str(), "wb", m_file) : std::fopen(m_path.c_str(), "wb");
+    m_failed = m_file == nullptr;
+    throwIfFailed();
+}
+
+void Journal::throwIfFailed() const {
+    if (m_failed)
+        throw FileOperationException(m_path, "write journal");
+}
+
+void Journal::writerLoop() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastSync = Clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        bool syncDue = m_syncRequested || m_policy == SyncPolicy::EveryCommit ||
+                       (m_policy == SyncPolicy::Periodic &&
+                        (m_stopping || Clock::now() - lastSync >= m_syncInterval));
+        if (m_pending.empty() && !(m_unsynced && syncDue)) {
+            m_syncRequested = false;
+            if (m_stopping) return;
+            if (m_unsynced && m_policy == SyncPolicy::Periodic)
+                m_wake.wait_until(lock, lastSync + m_syncInterval);
+            else
+                m_wake.wait(lock);
+            continue;
+        }
+
+        std::string batch;
+        batch.swap(m_pending);
+        std::uint64_t batchEnd = m_appended;
+        m_syncRequested = false;
+        m_writing = true;
+        lock.unlock();
+
+        bool ok = m_file && std::fwrite(batch.data(), 1, batch.size(), m_file) == batch.size();
+        ok = ok && (syncDue ? syncFile(m_file) : std::fflush(m_file) == 0);
+
+        lock.lock();
+        if (syncDue) lastSync = Clock::now();
+        m_unsynced = !syncDue;
+        m_written = batchEnd;
+        m_writing = false;
+        if (!ok) m_failed = true;
+        m_drained.notify_all();
+    }
+}
+
+std::size_t Journal::replay(const std::string &path, const std::function<void(const Record &)> &apply) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return 0;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    std::size_t offset = 0;
+    std::size_t applied = 0;
+    while (data.size() - offset >= kHeaderSize) {
+        const char *header = data.data() + offset;
+        std::uint32_t length = getU32(header);
+        if (length > data.size() - offset - kHeaderSize)
+            break;
+        std::string_view body(header + 8, 2 + length);
+        if (crc32(body) != getU32(header + 4))
+            break;
+        apply(Record{static_cast<Op>(body[0]), static_cast<Table>(body[1]), body.substr(2)});
+        offset += kHeaderSize + length;
+        ++applied;
+    }
+    if (offset < data.size()) {
+        std::cerr << "Discarding " << data.size() - offset << " bytes of incomplete journal records in " << path << std::endl;
+        std::error_code error;
+        std::filesystem::resize_file(path, offset, error);
+        if (error)
+            throw FileOperationException(path, "truncate journal");
+    }
+    return applied;
+}
+
+std::string Journal::encodeId(int id) {
+    std::string payload;
+    putU32(payload, static_cast<std::uint32_t>(id));
+    return payload;
+}
+
+bool Journal::decodeId(std::string_view payload, int &id) {
+    if (payload.size() != 4)
+        return false;
+    id = static_cast<int>(getU32(payload.data()));
+    return true;
+}
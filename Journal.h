@@ -0,0 +1,87 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Append-only write-ahead log of CRMSystem mutations. Each record is
+//   u32 payload length | u32 CRC-32 | u8 op | u8 table | payload
+// (little-endian; the CRC covers op, table and payload). append() queues
+// the record for a background writer that drains the queue in batches, so
+// one write (and at most one fsync) covers every record queued meanwhile.
+class Journal {
+public:
+    enum class Op : std::uint8_t { Add = 1, Modify = 2, Remove = 3 };
+    enum class Table : std::uint8_t { Agents = 1, Clients, Properties, Contracts, Inspections };
+
+    // When the writer fsyncs: after every batch, at most once per sync
+    // interval, or never (the OS decides; a crash of the process alone
+    // still loses nothing that was written).
+    enum class SyncPolicy : std::uint8_t { EveryCommit, Periodic, Never };
+
+    struct Record {
+        Op op;
+        Table table;
+        std::string_view payload;
+    };
+
+    explicit Journal(std::string path, SyncPolicy policy = SyncPolicy::EveryCommit,
+                     std::chrono::milliseconds syncInterval = std::chrono::milliseconds(100));
+    ~Journal(); // drains the queue and stops the writer
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    // Under EveryCommit, blocks until the record is written and fsynced
+    // (group commit: concurrent appends share one fsync) and throws
+    // FileOperationException if that failed. Otherwise it only queues.
+    void append(Op op, Table table, std::string_view payload);
+
+    // Blocks until every record appended so far is written and fsynced,
+    // whatever the policy. Throws FileOperationException if a write failed.
+    void sync();
+
+    // Empties the log once the state it describes has been saved elsewhere.
+    void checkpoint();
+
+    // Calls apply for each intact record of the log at `path`, in order.
+    // A torn or corrupt tail (from a crash mid-write) ends the replay and is
+    // cut off so new records follow the last good one. Returns the number
+    // of records applied; a missing file is an empty log.
+    static std::size_t replay(const std::string &path, const std::function<void(const Record &)> &apply);
+
+    // Payload of a Remove record.
+    static std::string encodeId(int id);
+    static bool decodeId(std::string_view payload, int &id);
+
+private:
+    void writerLoop();
+    void throwIfFailed() const;
+
+    std::string m_path;
+    SyncPolicy m_policy;
+    std::chrono::milliseconds m_syncInterval;
+    std::FILE *m_file = nullptr;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;    // writer: records queued, sync requested or stopping
+    std::condition_variable m_drained; // waiters: a batch finished
+    std::string m_pending;             // encoded records not yet handed to the writer
+    std::uint64_t m_appended = 0;      // records queued so far
+    std::uint64_t m_written = 0;       // records written so far
+    bool m_writing = false;            // the writer owns m_file
+    bool m_unsynced = false;           // written data not yet fsynced
+    bool m_syncRequested = false;
+    bool m_failed = false;
+    bool m_stopping = false;
+    std::thread m_writer;
+};
+
+#endif // JOURNAL_H
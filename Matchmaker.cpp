@@ -0,0 +1,92 @@
+#include "Matchmaker.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+Matchmaker::Matchmaker(const std::vector<Listing> &listings, const MatchOptions &options)
+    : m_options(options)
+{
+    std::vector<Listing> rent;
+    std::vector<Listing> sale;
+    for(const auto &l : listings) {
+        if(l.price <= 0) continue;
+        (l.market == Market::Rent ? rent : sale).push_back(l);
+    }
+    buildPool(m_rent, std::move(rent));
+    buildPool(m_sale, std::move(sale));
+}
+
+void Matchmaker::buildPool(Pool &pool, std::vector<Listing> listings) {
+    std::sort(listings.begin(), listings.end(),
+              [](const Listing &a, const Listing &b){ return a.price < b.price; });
+    pool.price.reserve(listings.size());
+    pool.sizePerPrice.reserve(listings.size());
+    pool.propertyId.reserve(listings.size());
+    for(const auto &l : listings) {
+        pool.price.push_back(l.price);
+        pool.sizePerPrice.push_back(l.sizeSqm / l.price);
+        pool.propertyId.push_back(l.propertyId);
+    }
+    if(!listings.empty()) {
+        std::vector<double> values = pool.sizePerPrice;
+        auto mid = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), mid, values.end());
+        if(*mid > 0) pool.medianSizePerPrice = *mid;
+    }
+}
+
+// True when `a` ranks ahead of `b`: higher score first, ties broken by id so
+// the ranking is deterministic. A heap ordered by this keeps the weakest of
+// the current top K at the front.
+static bool rankedBefore(const PropertyMatch &a, const PropertyMatch &b) {
+    if(a.score != b.score) return a.score > b.score;
+    return a.propertyId < b.propertyId;
+}
+
+ClientMatches Matchmaker::match(const Request &request) const {
+    ClientMatches result{request.clientId, {}};
+    const Pool &pool = request.market == Market::Rent ? m_rent : m_sale;
+    if(request.budget <= 0 || m_options.topK == 0 || pool.price.empty())
+        return result;
+
+    double budget = request.budget;
+    std::size_t first = std::lower_bound(pool.price.begin(), pool.price.end(),
+                                         budget * m_options.minBudgetFraction) - pool.price.begin();
+    std::size_t last = std::upper_bound(pool.price.begin(), pool.price.end(), budget) - pool.price.begin();
+
+    std::vector<PropertyMatch> &top = result.matches;
+    top.reserve(m_options.topK);
+    std::size_t examined = 0;
+    // Walk from the most expensive affordable listing downwards: the budget
+    // fit term only shrinks, so once even a perfect value score cannot beat
+    // the current K-th best we are done.
+    for(std::size_t i = last; i > first && examined < m_options.maxCandidates; ++examined) {
+        --i;
+        double fit = pool.price[i] / budget;
+        if(top.size() == m_options.topK &&
+           m_options.budgetFitWeight * fit + m_options.valueWeight < top.front().score)
+            break;
+        double value = std::min(pool.sizePerPrice[i] / pool.medianSizePerPrice, 2.0) / 2.0;
+        PropertyMatch candidate{pool.propertyId[i],
+                                m_options.budgetFitWeight * fit + m_options.valueWeight * value};
+        if(top.size() < m_options.topK) {
+            top.push_back(candidate);
+            std::push_heap(top.begin(), top.end(), rankedBefore);
+        } else if(rankedBefore(candidate, top.front())) {
+            std::pop_heap(top.begin(), top.end(), rankedBefore);
+            top.back() = candidate;
+            std::push_heap(top.begin(), top.end(), rankedBefore);
+        }
+    }
+    std::sort_heap(top.begin(), top.end(), rankedBefore);
+    return result;
+}
+
+std::vector<ClientMatches> Matchmaker::matchAll(const std::vector<Request> &requests, ThreadPool &pool) const {
+    std::vector<ClientMatches> results(requests.size());
+    pool.parallelFor(requests.size(), 1024, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            results[i] = match(requests[i]);
+        }
+    });
+    return results;
+}
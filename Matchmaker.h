@@ -0,0 +1,71 @@
+#ifndef MATCHMAKER_H
+#define MATCHMAKER_H
+
+#include <cstddef>
+#include <vector>
+
+class ThreadPool;
+
+// Tuning knobs for client-to-property matching.
+struct MatchOptions {
+    std::size_t topK = 10;             // matches returned per client
+    double minBudgetFraction = 0.6;    // ignore listings cheaper than this share of the budget
+    double budgetFitWeight = 0.7;      // weight of price / budget
+    double valueWeight = 0.3;          // weight of size-per-price against the market median
+    std::size_t maxCandidates = 4096;  // listings examined per client at most
+};
+
+struct PropertyMatch {
+    int propertyId;
+    double score; // higher is better, in [0, budgetFitWeight + valueWeight]
+};
+
+struct ClientMatches {
+    int clientId;
+    std::vector<PropertyMatch> matches; // best first
+};
+
+// Ranks available listings for many clients at once. Listings are bucketed by
+// rent/sale and sorted by price, so a client only walks the listings inside
+// its budget window, closest to the budget first, and stops as soon as no
+// cheaper listing can still enter its top K.
+class Matchmaker {
+public:
+    enum class Market { Rent, Sale };
+
+    struct Listing {
+        int propertyId;
+        Market market;
+        double price;
+        double sizeSqm;
+    };
+
+    struct Request {
+        int clientId;
+        Market market;
+        double budget;
+    };
+
+    Matchmaker(const std::vector<Listing> &listings, const MatchOptions &options);
+
+    ClientMatches match(const Request &request) const;
+    // Matches every request in parallel; results keep the order of `requests`.
+    std::vector<ClientMatches> matchAll(const std::vector<Request> &requests, ThreadPool &pool) const;
+
+private:
+    // Listings of one market sorted by price, stored column-wise.
+    struct Pool {
+        std::vector<double> price;
+        std::vector<double> sizePerPrice;
+        std::vector<int> propertyId;
+        double medianSizePerPrice = 1.0;
+    };
+
+    void buildPool(Pool &pool, std::vector<Listing> listings);
+
+    MatchOptions m_options;
+    Pool m_rent;
+    Pool m_sale;
+};
+
+#endif // MATCHMAKER_H
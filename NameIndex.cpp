@@ -0,0 +1,59 @@
+#include "NameIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+// Lowercase and collapse runs of whitespace to one space, trimming the ends.
+std::string NameIndex::normalize(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    bool pendingSpace = false;
+    for(char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if(std::isspace(c)) {
+            pendingSpace = !out.empty();
+            continue;
+        }
+        if(pendingSpace) {
+            out.push_back(' ');
+            pendingSpace = false;
+        }
+        out.push_back(static_cast<char>(std::tolower(c)));
+    }
+    return out;
+}
+
+static std::string joinName(std::string_view a, std::string_view b) {
+    std::string joined(a);
+    joined.push_back(' ');
+    joined.append(b.data(), b.size());
+    return NameIndex::normalize(joined);
+}
+
+void NameIndex::insert(int id, std::string_view firstName, std::string_view lastName) {
+    m_keys.emplace(joinName(firstName, lastName), id);
+    m_keys.emplace(joinName(lastName, firstName), id);
+}
+
+void NameIndex::erase(int id, std::string_view firstName, std::string_view lastName) {
+    m_keys.erase({joinName(firstName, lastName), id});
+    m_keys.erase({joinName(lastName, firstName), id});
+}
+
+void NameIndex::clear() {
+    m_keys.clear();
+}
+
+std::vector<int> NameIndex::complete(std::string_view prefix, std::size_t limit) const {
+    std::vector<int> ids;
+    std::string key = normalize(prefix);
+    for(auto it = m_keys.lower_bound({key, std::numeric_limits<int>::min()});
+        it != m_keys.end() && ids.size() < limit; ++it) {
+        if(it->first.compare(0, key.size(), key) != 0)
+            break;
+        // The same person can match through both name orders.
+        if(std::find(ids.begin(), ids.end(), it->second) == ids.end())
+            ids.push_back(it->second);
+    }
+    return ids;
+}
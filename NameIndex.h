@@ -0,0 +1,31 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Ordered index of person names for prefix lookups ("autocomplete"). Every
+// person is indexed as "first last" and "last first", lowercased, so typing
+// the start of either name finds them. Lookups are a lower_bound plus a walk
+// over the matching range.
+class NameIndex {
+public:
+    void insert(int id, std::string_view firstName, std::string_view lastName);
+    void erase(int id, std::string_view firstName, std::string_view lastName);
+    void clear();
+
+    // Ids whose name starts with `prefix` (case-insensitive), in name order,
+    // at most `limit` of them.
+    std::vector<int> complete(std::string_view prefix, std::size_t limit) const;
+
+    static std::string normalize(std::string_view text);
+
+private:
+    std::set<std::pair<std::string, int>> m_keys;
+};
+
+#endif // NAMEINDEX_H
@@ -0,0 +1,46 @@
+#include "PlaceDictionary.h"
+#include <mutex>
+
+PlaceDictionary &PlaceDictionary::instance() {
+    static PlaceDictionary dictionary;
+    return dictionary;
+}
+
+PlaceDictionary::PlaceDictionary() {
+    intern("");
+}
+
+std::uint32_t PlaceDictionary::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto found = m_ids.find(name);
+        if (found != m_ids.end())
+            return found->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto found = m_ids.find(name);
+    if (found != m_ids.end())
+        return found->second;
+    std::uint32_t id = static_cast<std::uint32_t>(m_names.size());
+    m_names.emplace_back(name);
+    m_ids.emplace(m_names.back(), id);
+    return id;
+}
+
+std::optional<std::uint32_t> PlaceDictionary::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto found = m_ids.find(name);
+    if (found == m_ids.end())
+        return std::nullopt;
+    return found->second;
+}
+
+const std::string &PlaceDictionary::name(std::uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_names.at(id);
+}
+
+std::size_t PlaceDictionary::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_names.size();
+}
@@ -0,0 +1,36 @@
+#ifndef PLACEDICTIONARY_H
+#define PLACEDICTIONARY_H
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Process-wide dictionary of place names. Every distinct name is stored once
+// and identified by a dense 32-bit id, so properties in the same town share a
+// single string and place comparisons are integer compares. Id 0 is the
+// empty name. Safe to use from several threads.
+class PlaceDictionary {
+public:
+    static PlaceDictionary &instance();
+
+    // Id of `name`, adding it if it is new.
+    std::uint32_t intern(std::string_view name);
+    // Id of `name` if it was ever interned.
+    std::optional<std::uint32_t> find(std::string_view name) const;
+    // Name of a previously returned id; the reference stays valid forever.
+    const std::string &name(std::uint32_t id) const;
+    std::size_t size() const;
+
+private:
+    PlaceDictionary();
+
+    mutable std::shared_mutex m_mutex;
+    std::deque<std::string> m_names; // deque: growing never moves existing names
+    std::unordered_map<std::string_view, std::uint32_t> m_ids; // keys view into m_names
+};
+
+#endif // PLACEDICTIONARY_H
@@ -1,14 +1,16 @@
 #include "Property.h"
 #include "Exceptions.h"
 #include <stdexcept>
-#include <algorithm>
 
-Property::Property() : m_id(-1), m_sizeSqm(0.0), m_price(0.0), m_bedrooms(0), m_bathrooms(0), m_available(true) {}
+Property::Property()
+    : m_id(-1), m_sizeSqm(0.0), m_price(0.0), m_propertyType(PropertyType::House), m_bedrooms(0), m_bathrooms(0),
+      m_placeId(0), m_available(true), m_listingType(ListingType::Sale) {}
 
 Property::Property(int id, double sizeSqm, double price, const std::string &propertyType,
                    int bedrooms, int bathrooms, const std::string &place,
                    bool available, const std::string &listingType)
-    : m_id(id), m_sizeSqm(sizeSqm), m_price(price), m_bedrooms(bedrooms), m_bathrooms(bathrooms), m_place(place), m_available(available)
+    : m_id(id), m_sizeSqm(sizeSqm), m_price(price), m_propertyType(PropertyType::House), m_bedrooms(bedrooms),
+      m_bathrooms(bathrooms), m_placeId(PlaceDictionary::instance().intern(place)), m_available(available), m_listingType(ListingType::Sale)
 {
     setPropertyType(propertyType);
     setListingType(listingType);
@@ -17,43 +19,45 @@ Property::Property(int id, double sizeSqm, double price, const std::string &prop
 int Property::getId() const { return m_id; }
 double Property::getSizeSqm() const { return m_sizeSqm; }
 double Property::getPrice() const { return m_price; }
-std::string Property::getPropertyType() const { return m_propertyType; }
+std::string_view Property::getPropertyType() const { return toString(m_propertyType); }
+PropertyType Property::getPropertyTypeEnum() const { return m_propertyType; }
 int Property::getBedrooms() const { return m_bedrooms; }
 int Property::getBathrooms() const { return m_bathrooms; }
-std::string Property::getPlace() const { return m_place; }
+const std::string &Property::getPlace() const { return PlaceDictionary::instance().name(m_placeId); }
+std::uint32_t Property::getPlaceId() const { return m_placeId; }
 bool Property::getAvailability() const { return m_available; }
-std::string Property::getListingType() const { return m_listingType; }
+std::string_view Property::getListingType() const { return toString(m_listingType); }
+ListingType Property::getListingTypeEnum() const { return m_listingType; }
 
 void Property::setId(int id) { m_id = id; }
 void Property::setSizeSqm(double sizeSqm) { m_sizeSqm = sizeSqm; }
 void Property::setPrice(double price) { m_price = price; }
 void Property::setPropertyType(const std::string &propertyTypeInput) {
-        // Make a copy and convert to lowercase
-    std::string propertyType = propertyTypeInput;
-    std::transform(propertyType.begin(), propertyType.end(), propertyType.begin(), ::tolower);
-
-    // Optionally trim leading/trailing spaces, then check
-    if (propertyType != "land" && propertyType != "house" && propertyType != "apartment")
+    std::optional<PropertyType> propertyType = parsePropertyType(propertyTypeInput);
+    if (!propertyType)
         throw ValidationException("Property type must be 'land', 'house', or 'apartment'.");
-    
-    m_propertyType = propertyTypeInput;
+    m_propertyType = *propertyType;
 }
+void Property::setPropertyType(PropertyType propertyType) { m_propertyType = propertyType; }
 void Property::setBedrooms(int bedrooms) { m_bedrooms = bedrooms; }
 void Property::setBathrooms(int bathrooms) { m_bathrooms = bathrooms; }
-void Property::setPlace(const std::string &place) { m_place = place; }
+void Property::setPlace(const std::string &place) { m_placeId = PlaceDictionary::instance().intern(place); }
+void Property::setPlaceId(std::uint32_t placeId) { m_placeId = placeId; }
 void Property::setAvailability(bool available) { m_available = available; }
-void Property::setListingType(const std::string &listingType) {
-    if (listingType != "sale" && listingType != "rent")
+void Property::setListingType(const std::string &listingTypeInput) {
+    std::optional<ListingType> listingType = parseListingType(listingTypeInput);
+    if (!listingType)
         throw ValidationException("Listing type must be 'sale' or 'rent'.");
-    m_listingType = listingType;
+    m_listingType = *listingType;
 }
+void Property::setListingType(ListingType listingType) { m_listingType = listingType; }
 
 bool Property::isValid() const {
     if(m_sizeSqm <= 0) return false;
     if(m_price < 0) return false;
-    if(m_propertyType != "land" && m_propertyType != "house" && m_propertyType != "apartment")return false;
+    if(!isKnown(m_propertyType))return false;
     if(m_bedrooms < 0 || m_bathrooms < 0)return false;
-    if(m_listingType != "sale" && m_listingType != "rent")return false;
+    if(!isKnown(m_listingType))return false;
 
     return true;
         
@@ -64,20 +68,30 @@ std::ostream& operator<<(std::ostream &os, const Property &property) {
     os << "ID: " << property.m_id
        << "\nSize: " << property.m_sizeSqm << " sqm"
        << "\nPrice: " << property.m_price
-       << "\nType: " << property.m_propertyType
+       << "\nType: " << toString(property.m_propertyType)
        << "\nBed: " << property.m_bedrooms
        << "\nBath: " << property.m_bathrooms
-       << "\nPlace: " << property.m_place
+       << "\nPlace: " << property.getPlace()
        << "\nAvailability: " << (property.m_available ? "Yes" : "No")
-       << "\nListing: " << property.m_listingType;
+       << "\nListing: " << toString(property.m_listingType);
     return os;
 }
 
 std::istream& operator>>(std::istream &is, Property &property) {
     // Order: id, sizeSqm, price, propertyType, bedrooms, bathrooms, place, available (0/1), listingType
     int avail;
-    is >> property.m_id >> property.m_sizeSqm >> property.m_price >> property.m_propertyType
-       >> property.m_bedrooms >> property.m_bathrooms >> property.m_place >> avail >> property.m_listingType;
+    std::string propertyType, listingType, place;
+    is >> property.m_id >> property.m_sizeSqm >> property.m_price >> propertyType
+       >> property.m_bedrooms >> property.m_bathrooms >> place >> avail >> listingType;
+    property.setPlace(place);
     property.m_available = (avail != 0);
+    std::optional<PropertyType> parsedType = parsePropertyType(propertyType);
+    std::optional<ListingType> parsedListing = parseListingType(listingType);
+    if (!parsedType || !parsedListing) {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
+    property.m_propertyType = *parsedType;
+    property.m_listingType = *parsedListing;
     return is;
 }
@@ -2,8 +2,12 @@
 #define PROPERTY_H
 
 #include <iostream>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include "Exceptions.h"
+#include "EntityTypes.h"
+#include "PlaceDictionary.h"
 
 class Property {
 public:
@@ -16,23 +20,29 @@ public:
     int getId() const;
     double getSizeSqm() const;
     double getPrice() const;
-    std::string getPropertyType() const;
+    std::string_view getPropertyType() const;
+    PropertyType getPropertyTypeEnum() const;
     int getBedrooms() const;
     int getBathrooms() const;
-    std::string getPlace() const;
+    const std::string &getPlace() const;
+    std::uint32_t getPlaceId() const; // id in PlaceDictionary
     bool getAvailability() const;
-    std::string getListingType() const;
+    std::string_view getListingType() const;
+    ListingType getListingTypeEnum() const;
 
     // Setters
     void setId(int id);
     void setSizeSqm(double sizeSqm);
     void setPrice(double price);
     void setPropertyType(const std::string &propertyType); // "land", "house", or "apartment"
+    void setPropertyType(PropertyType propertyType);
     void setBedrooms(int bedrooms);
     void setBathrooms(int bathrooms);
     void setPlace(const std::string &place);
+    void setPlaceId(std::uint32_t placeId);
     void setAvailability(bool available);
     void setListingType(const std::string &listingType); // "sale" or "rent"
+    void setListingType(ListingType listingType);
 
     // Validation
     bool isValid() const;
@@ -45,12 +55,12 @@ private:
     int m_id;
     double m_sizeSqm;
     double m_price;
-    std::string m_propertyType;
+    PropertyType m_propertyType;
     int m_bedrooms;
     int m_bathrooms;
-    std::string m_place;
+    std::uint32_t m_placeId;
     bool m_available;
-    std::string m_listingType;
+    ListingType m_listingType;
 };
 
 #endif // PROPERTY_H
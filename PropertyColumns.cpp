@@ -0,0 +1,172 @@
+#include "PropertyColumns.h"
+#include <algorithm>
+
+void PropertyColumns::writeRow(std::size_t row, const Property &property) {
+    m_ids[row] = property.getId();
+    m_price[row] = property.getPrice();
+    m_sizeSqm[row] = property.getSizeSqm();
+    m_bedrooms[row] = property.getBedrooms();
+    m_bathrooms[row] = property.getBathrooms();
+    m_available[row] = property.getAvailability() ? 1 : 0;
+    m_typeCode[row] = static_cast<std::uint8_t>(property.getPropertyTypeEnum());
+    m_listingCode[row] = static_cast<std::uint8_t>(property.getListingTypeEnum());
+    m_placeCode[row] = property.getPlaceId();
+}
+
+void PropertyColumns::insert(const Property &property) {
+    auto found = m_rowOf.find(property.getId());
+    if(found != m_rowOf.end()) {
+        writeRow(found->second, property);
+        return;
+    }
+    std::size_t row = m_ids.size();
+    m_ids.emplace_back();
+    m_price.emplace_back();
+    m_sizeSqm.emplace_back();
+    m_bedrooms.emplace_back();
+    m_bathrooms.emplace_back();
+    m_available.emplace_back();
+    m_typeCode.emplace_back();
+    m_listingCode.emplace_back();
+    m_placeCode.emplace_back();
+    writeRow(row, property);
+    m_rowOf.emplace(property.getId(), row);
+}
+
+template <typename T>
+static void moveLastInto(std::vector<T> &column, std::size_t row) {
+    column[row] = column.back();
+    column.pop_back();
+}
+
+void PropertyColumns::erase(int propertyId) {
+    auto found = m_rowOf.find(propertyId);
+    if(found == m_rowOf.end()) return;
+    std::size_t row = found->second;
+    m_rowOf.erase(found);
+    if(row + 1 != m_ids.size())
+        m_rowOf[m_ids.back()] = row;
+    moveLastInto(m_ids, row);
+    moveLastInto(m_price, row);
+    moveLastInto(m_sizeSqm, row);
+    moveLastInto(m_bedrooms, row);
+    moveLastInto(m_bathrooms, row);
+    moveLastInto(m_available, row);
+    moveLastInto(m_typeCode, row);
+    moveLastInto(m_listingCode, row);
+    moveLastInto(m_placeCode, row);
+}
+
+void PropertyColumns::clear() {
+    m_rowOf.clear();
+    m_ids.clear();
+    m_price.clear();
+    m_sizeSqm.clear();
+    m_bedrooms.clear();
+    m_bathrooms.clear();
+    m_available.clear();
+    m_typeCode.clear();
+    m_listingCode.clear();
+    m_placeCode.clear();
+}
+
+void PropertyColumns::reserve(std::size_t n) {
+    m_rowOf.reserve(n);
+    m_ids.reserve(n);
+    m_price.reserve(n);
+    m_sizeSqm.reserve(n);
+    m_bedrooms.reserve(n);
+    m_bathrooms.reserve(n);
+    m_available.reserve(n);
+    m_typeCode.reserve(n);
+    m_listingCode.reserve(n);
+    m_placeCode.reserve(n);
+}
+
+PropertyColumnView PropertyColumns::view() const {
+    PropertyColumnView view;
+    view.rows = m_ids.size();
+    view.price = m_price.data();
+    view.sizeSqm = m_sizeSqm.data();
+    view.bedrooms = m_bedrooms.data();
+    view.available = m_available.data();
+    view.typeCode = m_typeCode.data();
+    view.listingCode = m_listingCode.data();
+    view.placeCode = m_placeCode.data();
+    return view;
+}
+
+PropertyKernels::Bitmap PropertyColumns::select(const PropertyFilter &filter) const {
+    // A place that was never interned cannot match any row.
+    std::optional<std::uint32_t> placeId;
+    if(filter.place && !(placeId = PlaceDictionary::instance().find(*filter.place)))
+        return PropertyKernels::Bitmap((m_ids.size() + 63) / 64, 0);
+
+    PropertyPredicate predicate;
+    if(filter.minPrice || filter.maxPrice) {
+        predicate.usePrice = true;
+        if(filter.minPrice) predicate.minPrice = *filter.minPrice;
+        if(filter.maxPrice) predicate.maxPrice = *filter.maxPrice;
+    }
+    if(filter.minSize || filter.maxSize) {
+        predicate.useSize = true;
+        if(filter.minSize) predicate.minSize = *filter.minSize;
+        if(filter.maxSize) predicate.maxSize = *filter.maxSize;
+    }
+    if(filter.bedrooms) {
+        predicate.useBedrooms = true;
+        predicate.minBedrooms = predicate.maxBedrooms = *filter.bedrooms;
+    }
+    if(filter.minBedrooms) {
+        predicate.useBedrooms = true;
+        predicate.minBedrooms = std::max(predicate.minBedrooms, static_cast<std::int32_t>(*filter.minBedrooms));
+    }
+    if(filter.available) {
+        predicate.useAvailable = true;
+        predicate.available = *filter.available ? 1 : 0;
+    }
+    if(filter.propertyType) {
+        predicate.useType = true;
+        predicate.typeCode = static_cast<std::uint8_t>(*filter.propertyType);
+    }
+    if(filter.listingType) {
+        predicate.useListing = true;
+        predicate.listingCode = static_cast<std::uint8_t>(*filter.listingType);
+    }
+    if(filter.place) {
+        predicate.usePlace = true;
+        predicate.placeCode = *placeId;
+    }
+    return PropertyKernels::evaluate(view(), predicate);
+}
+
+std::vector<int> PropertyColumns::selectIds(const PropertyFilter &filter) const {
+    PropertyKernels::Bitmap selected = select(filter);
+    std::vector<int> ids;
+    ids.reserve(PropertyKernels::countSelected(selected));
+    PropertyKernels::forEachSelected(selected, [&](std::size_t row){ ids.push_back(m_ids[row]); });
+    return ids;
+}
+
+PropertyStats PropertyColumns::aggregate(const PropertyFilter &filter) const {
+    PropertyKernels::Bitmap selected = select(filter);
+    PropertyStatsBuilder stats;
+    PropertyKernels::forEachSelected(selected, [&](std::size_t row) {
+        stats.add(m_price[row], m_sizeSqm[row]);
+    });
+    return stats.result();
+}
+
+std::unordered_map<std::uint32_t, PropertyStats> PropertyColumns::aggregateByPlace(const PropertyFilter &filter) const {
+    PropertyKernels::Bitmap selected = select(filter);
+    std::unordered_map<std::uint32_t, PropertyStatsBuilder> groups;
+    PropertyKernels::forEachSelected(selected, [&](std::size_t row) {
+        groups[m_placeCode[row]].add(m_price[row], m_sizeSqm[row]);
+    });
+    std::unordered_map<std::uint32_t, PropertyStats> result;
+    result.reserve(groups.size());
+    for(const auto &group : groups) {
+        result.emplace(group.first, group.second.result());
+    }
+    return result;
+}
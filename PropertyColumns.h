@@ -0,0 +1,91 @@
+#ifndef PROPERTYCOLUMNS_H
+#define PROPERTYCOLUMNS_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Property.h"
+#include "PropertyIndex.h"
+#include "PropertyKernels.h"
+
+// Summary of the properties matching a filter.
+struct PropertyStats {
+    std::size_t count = 0;
+    double minPrice = 0.0;
+    double maxPrice = 0.0;
+    double averagePrice = 0.0;
+    double averageSizeSqm = 0.0;
+};
+
+// Accumulates PropertyStats one property at a time.
+class PropertyStatsBuilder {
+public:
+    void add(double price, double sizeSqm) {
+        if(m_stats.count == 0 || price < m_stats.minPrice) m_stats.minPrice = price;
+        if(m_stats.count == 0 || price > m_stats.maxPrice) m_stats.maxPrice = price;
+        m_priceSum += price;
+        m_sizeSum += sizeSqm;
+        ++m_stats.count;
+    }
+
+    PropertyStats result() const {
+        PropertyStats stats = m_stats;
+        if(stats.count > 0) {
+            stats.averagePrice = m_priceSum / stats.count;
+            stats.averageSizeSqm = m_sizeSum / stats.count;
+        }
+        return stats;
+    }
+
+private:
+    PropertyStats m_stats;
+    double m_priceSum = 0.0;
+    double m_sizeSum = 0.0;
+};
+
+// Column-oriented mirror of the property table. Each attribute lives in its
+// own contiguous array; type and listing type are stored as their one-byte
+// enum codes and place as its PlaceDictionary id, so a filter or aggregate only reads the columns it
+// actually needs. Filters are evaluated by the SIMD kernels in PropertyKernels.
+// Rows are unordered; erasing moves the last row into the hole.
+class PropertyColumns {
+public:
+    void insert(const Property &property); // inserts or overwrites by id
+    void erase(int propertyId);
+    void clear();
+    void reserve(std::size_t n);
+    std::size_t size() const { return m_ids.size(); }
+
+    // Selection bitmap over the rows, evaluated by the widest predicate
+    // kernel the CPU supports.
+    PropertyKernels::Bitmap select(const PropertyFilter &filter) const;
+    std::vector<int> selectIds(const PropertyFilter &filter) const;
+    PropertyStats aggregate(const PropertyFilter &filter) const;
+    // Same as aggregate, grouped by place id.
+    std::unordered_map<std::uint32_t, PropertyStats> aggregateByPlace(const PropertyFilter &filter) const;
+
+    const std::vector<int> &ids() const { return m_ids; }
+    const std::vector<double> &prices() const { return m_price; }
+    const std::vector<double> &sizes() const { return m_sizeSqm; }
+    const std::vector<std::int32_t> &bedrooms() const { return m_bedrooms; }
+    const std::vector<std::int32_t> &bathrooms() const { return m_bathrooms; }
+    const std::vector<std::uint8_t> &availability() const { return m_available; }
+
+private:
+    void writeRow(std::size_t row, const Property &property);
+    PropertyColumnView view() const;
+
+    std::unordered_map<int, std::size_t> m_rowOf;
+    std::vector<int> m_ids;
+    std::vector<double> m_price;
+    std::vector<double> m_sizeSqm;
+    std::vector<std::int32_t> m_bedrooms;
+    std::vector<std::int32_t> m_bathrooms;
+    std::vector<std::uint8_t> m_available;
+    std::vector<std::uint8_t> m_typeCode;
+    std::vector<std::uint8_t> m_listingCode;
+    std::vector<std::uint32_t> m_placeCode;
+};
+
+#endif // PROPERTYCOLUMNS_H
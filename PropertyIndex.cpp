@@ -0,0 +1,169 @@
+#include "PropertyIndex.h"
+#include <limits>
+
+bool PropertyFilter::hasIndexedCriteria() const {
+    return minPrice || maxPrice || minSize || maxSize || propertyType || listingType || place || bedrooms;
+}
+
+bool PropertyFilter::matches(const Property &p) const {
+    if(minPrice && p.getPrice() < *minPrice) return false;
+    if(maxPrice && p.getPrice() > *maxPrice) return false;
+    if(minSize && p.getSizeSqm() < *minSize) return false;
+    if(maxSize && p.getSizeSqm() > *maxSize) return false;
+    if(propertyType && p.getPropertyTypeEnum() != *propertyType) return false;
+    if(listingType && p.getListingTypeEnum() != *listingType) return false;
+    if(place && p.getPlace() != *place) return false;
+    if(bedrooms && p.getBedrooms() != *bedrooms) return false;
+    if(minBedrooms && p.getBedrooms() < *minBedrooms) return false;
+    if(available && p.getAvailability() != *available) return false;
+    return true;
+}
+
+void PropertyIndex::insert(const Property &property) {
+    int id = property.getId();
+    erase(id);
+    Entry entry{property.getPrice(), property.getSizeSqm(), property.getPropertyTypeEnum(),
+                property.getListingTypeEnum(), property.getPlaceId(), property.getBedrooms()};
+    m_byPrice.emplace(entry.price, id);
+    m_bySize.emplace(entry.sizeSqm, id);
+    m_byType[entry.propertyType].insert(id);
+    m_byListing[entry.listingType].insert(id);
+    m_byPlace[entry.placeId].insert(id);
+    m_byBedrooms[entry.bedrooms].insert(id);
+    m_entries.emplace(id, std::move(entry));
+}
+
+template <typename Key>
+static void eraseFromBucket(std::unordered_map<Key, std::unordered_set<int>> &index, const Key &key, int id) {
+    auto bucket = index.find(key);
+    if(bucket == index.end()) return;
+    bucket->second.erase(id);
+    if(bucket->second.empty())
+        index.erase(bucket);
+}
+
+void PropertyIndex::erase(int propertyId) {
+    auto found = m_entries.find(propertyId);
+    if(found == m_entries.end()) return;
+    const Entry &entry = found->second;
+    m_byPrice.erase({entry.price, propertyId});
+    m_bySize.erase({entry.sizeSqm, propertyId});
+    eraseFromBucket(m_byType, entry.propertyType, propertyId);
+    eraseFromBucket(m_byListing, entry.listingType, propertyId);
+    eraseFromBucket(m_byPlace, entry.placeId, propertyId);
+    eraseFromBucket(m_byBedrooms, entry.bedrooms, propertyId);
+    m_entries.erase(found);
+}
+
+void PropertyIndex::clear() {
+    m_entries.clear();
+    m_byPrice.clear();
+    m_bySize.clear();
+    m_byType.clear();
+    m_byListing.clear();
+    m_byPlace.clear();
+    m_byBedrooms.clear();
+}
+
+void PropertyIndex::reserve(std::size_t n) {
+    m_entries.reserve(n);
+}
+
+// [first, last) of the entries whose key lies in [lo, hi].
+static std::pair<std::set<std::pair<double, int>>::const_iterator, std::set<std::pair<double, int>>::const_iterator>
+rangeOf(const std::set<std::pair<double, int>> &index, const std::optional<double> &lo, const std::optional<double> &hi) {
+    auto first = lo ? index.lower_bound({*lo, std::numeric_limits<int>::min()}) : index.begin();
+    auto last = hi ? index.upper_bound({*hi, std::numeric_limits<int>::max()}) : index.end();
+    if(lo && hi && *lo > *hi) last = first;
+    return {first, last};
+}
+
+// Size of a range, but stop counting once it exceeds `limit`.
+template <typename It>
+static std::size_t countUpTo(It first, It last, std::size_t limit) {
+    std::size_t n = 0;
+    for(; first != last && n <= limit; ++first) ++n;
+    return n;
+}
+
+std::vector<int> PropertyIndex::find(const PropertyFilter &filter) const {
+    std::vector<int> result;
+
+    // Resolve hash criteria to their buckets; a missing bucket means no match.
+    const std::unordered_set<int> *buckets[4] = {nullptr, nullptr, nullptr, nullptr};
+    auto lookup = [](const auto &index, const auto &key) -> const std::unordered_set<int>* {
+        auto it = index.find(key);
+        return it != index.end() ? &it->second : nullptr;
+    };
+    if(filter.propertyType && !(buckets[0] = lookup(m_byType, *filter.propertyType))) return result;
+    if(filter.listingType && !(buckets[1] = lookup(m_byListing, *filter.listingType))) return result;
+    if(filter.place) {
+        std::optional<std::uint32_t> placeId = PlaceDictionary::instance().find(*filter.place);
+        if(!placeId || !(buckets[2] = lookup(m_byPlace, *placeId))) return result;
+    }
+    if(filter.bedrooms && !(buckets[3] = lookup(m_byBedrooms, *filter.bedrooms))) return result;
+
+    // Pick the smallest candidate set to drive the intersection.
+    const std::unordered_set<int> *driverBucket = nullptr;
+    std::size_t best = m_entries.size();
+    for(const auto *bucket : buckets) {
+        if(bucket && bucket->size() < best) {
+            best = bucket->size();
+            driverBucket = bucket;
+        }
+    }
+    auto priceRange = rangeOf(m_byPrice, filter.minPrice, filter.maxPrice);
+    auto sizeRange = rangeOf(m_bySize, filter.minSize, filter.maxSize);
+    const RangeIndex *driverRange = nullptr;
+    if(filter.minPrice || filter.maxPrice) {
+        std::size_t n = countUpTo(priceRange.first, priceRange.second, best);
+        if(n < best) { best = n; driverRange = &m_byPrice; driverBucket = nullptr; }
+    }
+    if(filter.minSize || filter.maxSize) {
+        std::size_t n = countUpTo(sizeRange.first, sizeRange.second, best);
+        if(n < best) { best = n; driverRange = &m_bySize; driverBucket = nullptr; }
+    }
+    result.reserve(best);
+
+    auto matches = [&](int id) {
+        const Entry &e = m_entries.at(id);
+        if(filter.minPrice && e.price < *filter.minPrice) return false;
+        if(filter.maxPrice && e.price > *filter.maxPrice) return false;
+        if(filter.minSize && e.sizeSqm < *filter.minSize) return false;
+        if(filter.maxSize && e.sizeSqm > *filter.maxSize) return false;
+        for(const auto *bucket : buckets) {
+            if(bucket && bucket != driverBucket && !bucket->count(id)) return false;
+        }
+        return true;
+    };
+
+    if(driverRange) {
+        auto range = driverRange == &m_byPrice ? priceRange : sizeRange;
+        for(auto it = range.first; it != range.second; ++it) {
+            if(matches(it->second)) result.push_back(it->second);
+        }
+    } else if(driverBucket) {
+        for(int id : *driverBucket) {
+            if(matches(id)) result.push_back(id);
+        }
+    } else {
+        for(const auto &entry : m_entries) {
+            if(matches(entry.first)) result.push_back(entry.first);
+        }
+    }
+    return result;
+}
+
+const std::unordered_set<int> *PropertyIndex::inPlace(std::uint32_t placeId) const {
+    auto found = m_byPlace.find(placeId);
+    return found != m_byPlace.end() ? &found->second : nullptr;
+}
+
+std::unordered_map<std::uint32_t, std::size_t> PropertyIndex::countByPlace() const {
+    std::unordered_map<std::uint32_t, std::size_t> counts;
+    counts.reserve(m_byPlace.size());
+    for(const auto &bucket : m_byPlace) {
+        counts.emplace(bucket.first, bucket.second.size());
+    }
+    return counts;
+}
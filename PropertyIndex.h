@@ -0,0 +1,76 @@
+#ifndef PROPERTYINDEX_H
+#define PROPERTYINDEX_H
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Property.h"
+
+// Search criteria for CRMSystem::findProperties. Unset fields match anything;
+// range bounds are inclusive.
+struct PropertyFilter {
+    std::optional<double> minPrice;
+    std::optional<double> maxPrice;
+    std::optional<double> minSize;
+    std::optional<double> maxSize;
+    std::optional<PropertyType> propertyType;
+    std::optional<ListingType> listingType;
+    std::optional<std::string> place;
+    std::optional<int> bedrooms;
+    std::optional<int> minBedrooms;          // checked on the matches, not indexed
+    std::optional<bool> available;           // checked on the matches, not indexed
+
+    bool hasIndexedCriteria() const;
+    bool matches(const Property &property) const;
+};
+
+// Secondary indexes over the property table, keyed by property id.
+// Price and size are kept in ordered sets for range queries; type, listing
+// type, place and bedroom count are hash indexes. A query drives off the most
+// selective criterion and probes the remaining indexes for each candidate.
+class PropertyIndex {
+public:
+    void insert(const Property &property);
+    void erase(int propertyId);
+    void clear();
+    void reserve(std::size_t n);
+
+    // Ids of properties matching every indexed criterion of the filter.
+    // `minBedrooms` and `available` are not handled here. Without indexed
+    // criteria this returns every indexed id.
+    std::vector<int> find(const PropertyFilter &filter) const;
+
+    // Ids of the properties in a place, or nullptr if there are none.
+    const std::unordered_set<int> *inPlace(std::uint32_t placeId) const;
+    // Number of properties per place id.
+    std::unordered_map<std::uint32_t, std::size_t> countByPlace() const;
+
+private:
+    struct Entry {
+        double price;
+        double sizeSqm;
+        PropertyType propertyType;
+        ListingType listingType;
+        std::uint32_t placeId;
+        int bedrooms;
+    };
+
+    using RangeIndex = std::set<std::pair<double, int>>;
+    template <typename Key>
+    using HashIndex = std::unordered_map<Key, std::unordered_set<int>>;
+
+    std::unordered_map<int, Entry> m_entries;
+    RangeIndex m_byPrice;
+    RangeIndex m_bySize;
+    HashIndex<PropertyType> m_byType;
+    HashIndex<ListingType> m_byListing;
+    HashIndex<std::uint32_t> m_byPlace; // inverted index: place id -> property ids
+    HashIndex<int> m_byBedrooms;
+};
+
+#endif // PROPERTYINDEX_H
@@ -0,0 +1,211 @@
+#include "PropertyKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRM_SSE2_KERNEL 1
+#include <emmintrin.h>
+#endif
+
+// The AVX2 kernel is compiled with a per-function target attribute so the
+// rest of the program keeps the baseline instruction set; it is only called
+// after the CPU has been checked at runtime.
+#if defined(CRM_SSE2_KERNEL) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRM_AVX2_KERNEL 1
+#define CRM_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace PropertyKernels {
+
+static bool matchesRow(const PropertyColumnView &c, const PropertyPredicate &p, std::size_t i) {
+    if (p.usePrice && !(c.price[i] >= p.minPrice && c.price[i] <= p.maxPrice)) return false;
+    if (p.useSize && !(c.sizeSqm[i] >= p.minSize && c.sizeSqm[i] <= p.maxSize)) return false;
+    if (p.useBedrooms && !(c.bedrooms[i] >= p.minBedrooms && c.bedrooms[i] <= p.maxBedrooms)) return false;
+    if (p.useAvailable && c.available[i] != p.available) return false;
+    if (p.useType && c.typeCode[i] != p.typeCode) return false;
+    if (p.useListing && c.listingCode[i] != p.listingCode) return false;
+    if (p.usePlace && c.placeCode[i] != p.placeCode) return false;
+    return true;
+}
+
+static void evaluateScalar(const PropertyColumnView &c, const PropertyPredicate &p, std::size_t from,
+                           std::uint64_t *out) {
+    for (std::size_t i = from; i < c.rows; ++i) {
+        if (matchesRow(c, p, i))
+            out[i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+}
+
+#if defined(CRM_SSE2_KERNEL)
+// Each helper evaluates one term for a group of 8 consecutive rows and
+// returns an 8-bit mask, bit k set when row k matches.
+static inline unsigned sse2Range8(const double *v, __m128d lo, __m128d hi) {
+    unsigned bits = 0;
+    for (int k = 0; k < 4; ++k) {
+        __m128d x = _mm_loadu_pd(v + 2 * k);
+        __m128d m = _mm_and_pd(_mm_cmpge_pd(x, lo), _mm_cmple_pd(x, hi));
+        bits |= static_cast<unsigned>(_mm_movemask_pd(m)) << (2 * k);
+    }
+    return bits;
+}
+
+static inline unsigned sse2IntRange8(const std::int32_t *v, __m128i lo, __m128i hi) {
+    unsigned bits = 0;
+    for (int k = 0; k < 2; ++k) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(v + 4 * k));
+        __m128i out = _mm_or_si128(_mm_cmpgt_epi32(lo, x), _mm_cmpgt_epi32(x, hi));
+        bits |= (~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(out))) & 0xFu) << (4 * k);
+    }
+    return bits;
+}
+
+static inline unsigned sse2ByteEq8(const std::uint8_t *v, __m128i want) {
+    __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(v));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, want))) & 0xFFu;
+}
+
+static inline unsigned sse2U32Eq8(const std::uint32_t *v, __m128i want) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(v));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(v + 4));
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, want)))) |
+           (static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(b, want)))) << 4);
+}
+
+static void evaluateSse2(const PropertyColumnView &c, const PropertyPredicate &p, std::uint64_t *out) {
+    const __m128d priceLo = _mm_set1_pd(p.minPrice), priceHi = _mm_set1_pd(p.maxPrice);
+    const __m128d sizeLo = _mm_set1_pd(p.minSize), sizeHi = _mm_set1_pd(p.maxSize);
+    const __m128i bedLo = _mm_set1_epi32(p.minBedrooms), bedHi = _mm_set1_epi32(p.maxBedrooms);
+    const __m128i avail = _mm_set1_epi8(static_cast<char>(p.available));
+    const __m128i type = _mm_set1_epi8(static_cast<char>(p.typeCode));
+    const __m128i listing = _mm_set1_epi8(static_cast<char>(p.listingCode));
+    const __m128i place = _mm_set1_epi32(static_cast<int>(p.placeCode));
+
+    std::size_t groups = c.rows / 8;
+    for (std::size_t g = 0; g < groups; ++g) {
+        std::size_t i = g * 8;
+        unsigned bits = 0xFFu;
+        if (p.usePrice) bits &= sse2Range8(c.price + i, priceLo, priceHi);
+        if (p.useSize) bits &= sse2Range8(c.sizeSqm + i, sizeLo, sizeHi);
+        if (p.useBedrooms) bits &= sse2IntRange8(c.bedrooms + i, bedLo, bedHi);
+        if (p.useAvailable) bits &= sse2ByteEq8(c.available + i, avail);
+        if (p.useType) bits &= sse2ByteEq8(c.typeCode + i, type);
+        if (p.useListing) bits &= sse2ByteEq8(c.listingCode + i, listing);
+        if (p.usePlace) bits &= sse2U32Eq8(c.placeCode + i, place);
+        out[i / 64] |= std::uint64_t(bits) << (i % 64);
+    }
+    evaluateScalar(c, p, groups * 8, out);
+}
+#endif
+
+#if defined(CRM_AVX2_KERNEL)
+CRM_AVX2_TARGET static inline unsigned avx2Range8(const double *v, __m256d lo, __m256d hi) {
+    __m256d a = _mm256_loadu_pd(v);
+    __m256d b = _mm256_loadu_pd(v + 4);
+    __m256d ma = _mm256_and_pd(_mm256_cmp_pd(a, lo, _CMP_GE_OQ), _mm256_cmp_pd(a, hi, _CMP_LE_OQ));
+    __m256d mb = _mm256_and_pd(_mm256_cmp_pd(b, lo, _CMP_GE_OQ), _mm256_cmp_pd(b, hi, _CMP_LE_OQ));
+    return static_cast<unsigned>(_mm256_movemask_pd(ma)) | (static_cast<unsigned>(_mm256_movemask_pd(mb)) << 4);
+}
+
+CRM_AVX2_TARGET static inline unsigned avx2IntRange8(const std::int32_t *v, __m256i lo, __m256i hi) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(v));
+    __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(lo, x), _mm256_cmpgt_epi32(x, hi));
+    return ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(out))) & 0xFFu;
+}
+
+CRM_AVX2_TARGET static inline unsigned avx2U32Eq8(const std::uint32_t *v, __m256i want) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(v));
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, want))));
+}
+
+CRM_AVX2_TARGET static void evaluateAvx2(const PropertyColumnView &c, const PropertyPredicate &p,
+                                         std::uint64_t *out) {
+    const __m256d priceLo = _mm256_set1_pd(p.minPrice), priceHi = _mm256_set1_pd(p.maxPrice);
+    const __m256d sizeLo = _mm256_set1_pd(p.minSize), sizeHi = _mm256_set1_pd(p.maxSize);
+    const __m256i bedLo = _mm256_set1_epi32(p.minBedrooms), bedHi = _mm256_set1_epi32(p.maxBedrooms);
+    const __m128i avail = _mm_set1_epi8(static_cast<char>(p.available));
+    const __m128i type = _mm_set1_epi8(static_cast<char>(p.typeCode));
+    const __m128i listing = _mm_set1_epi8(static_cast<char>(p.listingCode));
+    const __m256i place = _mm256_set1_epi32(static_cast<int>(p.placeCode));
+
+    std::size_t groups = c.rows / 8;
+    for (std::size_t g = 0; g < groups; ++g) {
+        std::size_t i = g * 8;
+        unsigned bits = 0xFFu;
+        if (p.usePrice) bits &= avx2Range8(c.price + i, priceLo, priceHi);
+        if (p.useSize) bits &= avx2Range8(c.sizeSqm + i, sizeLo, sizeHi);
+        if (p.useBedrooms) bits &= avx2IntRange8(c.bedrooms + i, bedLo, bedHi);
+        if (p.useAvailable) bits &= sse2ByteEq8(c.available + i, avail);
+        if (p.useType) bits &= sse2ByteEq8(c.typeCode + i, type);
+        if (p.useListing) bits &= sse2ByteEq8(c.listingCode + i, listing);
+        if (p.usePlace) bits &= avx2U32Eq8(c.placeCode + i, place);
+        out[i / 64] |= std::uint64_t(bits) << (i % 64);
+    }
+    evaluateScalar(c, p, groups * 8, out);
+}
+#endif
+
+static Isa detectIsa() {
+#if defined(CRM_AVX2_KERNEL)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Isa::AVX2;
+#endif
+#if defined(CRM_SSE2_KERNEL)
+    return Isa::SSE2;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+Isa bestIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+const char *isaName(Isa isa) {
+    switch (isa) {
+    case Isa::AVX2: return "avx2";
+    case Isa::SSE2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+Bitmap evaluate(const PropertyColumnView &columns, const PropertyPredicate &predicate) {
+    return evaluate(columns, predicate, bestIsa());
+}
+
+Bitmap evaluate(const PropertyColumnView &columns, const PropertyPredicate &predicate, Isa isa) {
+    Bitmap bitmap((columns.rows + 63) / 64, 0);
+    // Never run a kernel the CPU (or this build) cannot execute.
+    if (static_cast<int>(isa) > static_cast<int>(bestIsa()))
+        isa = bestIsa();
+    switch (isa) {
+#if defined(CRM_AVX2_KERNEL)
+    case Isa::AVX2:
+        evaluateAvx2(columns, predicate, bitmap.data());
+        break;
+#endif
+#if defined(CRM_SSE2_KERNEL)
+    case Isa::SSE2:
+        evaluateSse2(columns, predicate, bitmap.data());
+        break;
+#endif
+    default:
+        evaluateScalar(columns, predicate, 0, bitmap.data());
+        break;
+    }
+    return bitmap;
+}
+
+std::size_t countSelected(const Bitmap &bitmap) {
+    std::size_t n = 0;
+    for (std::uint64_t word : bitmap) {
+#if defined(__GNUC__)
+        n += static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+        for (; word; word &= word - 1) ++n;
+#endif
+    }
+    return n;
+}
+
+} // namespace PropertyKernels
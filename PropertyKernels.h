@@ -0,0 +1,91 @@
+#ifndef PROPERTYKERNELS_H
+#define PROPERTYKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Read-only view of the hot property columns a predicate can touch. Columns
+// a predicate does not use may be left null.
+struct PropertyColumnView {
+    std::size_t rows = 0;
+    const double *price = nullptr;
+    const double *sizeSqm = nullptr;
+    const std::int32_t *bedrooms = nullptr;
+    const std::uint8_t *available = nullptr;
+    const std::uint8_t *typeCode = nullptr;
+    const std::uint8_t *listingCode = nullptr;
+    const std::uint32_t *placeCode = nullptr;
+};
+
+// Compound predicate evaluated in a single pass. Ranges are inclusive; the
+// use* flags switch individual terms on.
+struct PropertyPredicate {
+    bool usePrice = false;
+    double minPrice = -std::numeric_limits<double>::infinity();
+    double maxPrice = std::numeric_limits<double>::infinity();
+
+    bool useSize = false;
+    double minSize = -std::numeric_limits<double>::infinity();
+    double maxSize = std::numeric_limits<double>::infinity();
+
+    bool useBedrooms = false;
+    std::int32_t minBedrooms = std::numeric_limits<std::int32_t>::min();
+    std::int32_t maxBedrooms = std::numeric_limits<std::int32_t>::max();
+
+    bool useAvailable = false;
+    std::uint8_t available = 1;
+
+    bool useType = false;
+    std::uint8_t typeCode = 0;
+
+    bool useListing = false;
+    std::uint8_t listingCode = 0;
+
+    bool usePlace = false;
+    std::uint32_t placeCode = 0;
+};
+
+namespace PropertyKernels {
+
+enum class Isa { Scalar, SSE2, AVX2 };
+
+// Widest instruction set supported by this CPU (checked once at runtime).
+Isa bestIsa();
+const char *isaName(Isa isa);
+
+// Selection bitmap: bit i of word i/64 is set when row i matches.
+using Bitmap = std::vector<std::uint64_t>;
+
+Bitmap evaluate(const PropertyColumnView &columns, const PropertyPredicate &predicate);
+Bitmap evaluate(const PropertyColumnView &columns, const PropertyPredicate &predicate, Isa isa);
+
+std::size_t countSelected(const Bitmap &bitmap);
+
+inline unsigned lowestSetBit(std::uint64_t word) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned bit = 0;
+    while (!(word & 1u)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// Calls fn(row) for every selected row in ascending order.
+template <typename Fn>
+void forEachSelected(const Bitmap &bitmap, Fn fn) {
+    for (std::size_t w = 0; w < bitmap.size(); ++w) {
+        for (std::uint64_t word = bitmap[w]; word; word &= word - 1) {
+            fn(w * 64 + lowestSetBit(word));
+        }
+    }
+}
+
+} // namespace PropertyKernels
+
+#endif // PROPERTYKERNELS_H
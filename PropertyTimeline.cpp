@@ -0,0 +1,55 @@
+#include "PropertyTimeline.h"
+#include <iterator>
+#include <limits>
+
+int PropertyTimeline::conflictWith(const Date &start, const Date &end) const {
+    auto next = m_bookings.upper_bound(endKey(end));
+    if(next == m_bookings.begin())
+        return -1;
+    auto previous = std::prev(next);
+    return previous->second.end >= start.toDays() ? previous->second.contractId : -1;
+}
+
+bool PropertyTimeline::book(int contractId, const Date &start, const Date &end) {
+    if(conflictWith(start, end) != -1)
+        return false;
+    m_bookings.emplace(start.toDays(), Booking{endKey(end), contractId});
+    return true;
+}
+
+void PropertyTimeline::release(int contractId, const Date &start) {
+    auto found = m_bookings.find(start.toDays());
+    if(found != m_bookings.end() && found->second.contractId == contractId)
+        m_bookings.erase(found);
+}
+
+bool PropertyTimeline::empty() const {
+    return m_bookings.empty();
+}
+
+std::vector<DateRange> PropertyTimeline::freePeriods(const Date &from, const Date &to) const {
+    std::vector<DateRange> result;
+    if(from.isEmpty() || to.isEmpty() || to < from)
+        return result;
+    std::int32_t cursor = from.toDays();
+    const std::int32_t last = to.toDays();
+
+    // Start from the booking that may already be running on `from`.
+    auto it = m_bookings.upper_bound(cursor);
+    if(it != m_bookings.begin())
+        --it;
+    for(; it != m_bookings.end() && it->first <= last; ++it) {
+        if(it->first > cursor)
+            result.push_back(DateRange{Date::fromDays(cursor), Date::fromDays(it->first - 1)});
+        if(it->second.end >= last)
+            return result;
+        if(it->second.end >= cursor)
+            cursor = it->second.end + 1;
+    }
+    result.push_back(DateRange{Date::fromDays(cursor), to});
+    return result;
+}
+
+std::int32_t PropertyTimeline::endKey(const Date &end) {
+    return end.isEmpty() ? std::numeric_limits<std::int32_t>::max() : end.toDays();
+}
@@ -0,0 +1,42 @@
+#ifndef PROPERTYTIMELINE_H
+#define PROPERTYTIMELINE_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "Date.h"
+
+// Closed range of days; an empty end means open-ended.
+struct DateRange {
+    Date start;
+    Date end;
+};
+
+// Date-ordered bookings of one property. Bookings never overlap, so they
+// are sorted by end as well as by start, and only the booking starting
+// at or before a requested end can clash with it: checks are O(log n).
+class PropertyTimeline {
+public:
+    // Contract id of a booking sharing a day with [start, end], or -1.
+    int conflictWith(const Date &start, const Date &end) const;
+    // Records the booking unless it conflicts; returns false if it does.
+    bool book(int contractId, const Date &start, const Date &end);
+    // Drops the booking at `start` if it belongs to `contractId`.
+    void release(int contractId, const Date &start);
+    bool empty() const;
+
+    // Maximal unbooked ranges inside [from, to], in date order.
+    std::vector<DateRange> freePeriods(const Date &from, const Date &to) const;
+
+private:
+    struct Booking {
+        std::int32_t end;
+        int contractId;
+    };
+
+    static std::int32_t endKey(const Date &end);
+
+    std::map<std::int32_t, Booking> m_bookings; // keyed by start day
+};
+
+#endif // PROPERTYTIMELINE_H
@@ -0,0 +1,71 @@
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+// Error codes reported by the non-throwing (tryX) API. Each has a matching
+// exception in Exceptions.h that the throwing API raises instead.
+enum class ErrorCode : std::uint8_t {
+    None,
+    InvalidData,
+    InvalidDate,
+    InvalidDateRange,
+    MalformedRecord,
+    DuplicateId,
+    DuplicateEmail,
+    DuplicatePhone,
+    BookingConflict,
+    AgentNotFound,
+    ClientNotFound,
+    PropertyNotFound,
+    ContractNotFound
+};
+
+constexpr std::string_view toString(ErrorCode error) {
+    switch(error) {
+        case ErrorCode::None: return "no error";
+        case ErrorCode::InvalidData: return "invalid data";
+        case ErrorCode::InvalidDate: return "invalid date";
+        case ErrorCode::InvalidDateRange: return "end date before start date";
+        case ErrorCode::MalformedRecord: return "malformed record";
+        case ErrorCode::DuplicateId: return "duplicate id";
+        case ErrorCode::DuplicateEmail: return "duplicate email";
+        case ErrorCode::DuplicatePhone: return "duplicate phone";
+        case ErrorCode::BookingConflict: return "property already booked";
+        case ErrorCode::AgentNotFound: return "agent not found";
+        case ErrorCode::ClientNotFound: return "client not found";
+        case ErrorCode::PropertyNotFound: return "property not found";
+        case ErrorCode::ContractNotFound: return "contract not found";
+    }
+    return "unknown error";
+}
+
+// Either a value or the ErrorCode explaining why there is none.
+template <typename T>
+class Result {
+public:
+    Result(const T &value) : m_value(value), m_error(ErrorCode::None) {}
+    Result(T &&value) : m_value(std::move(value)), m_error(ErrorCode::None) {}
+    Result(ErrorCode error) : m_error(error) {}
+
+    bool ok() const { return m_error == ErrorCode::None; }
+    explicit operator bool() const { return ok(); }
+    ErrorCode error() const { return m_error; }
+
+    // Only valid when ok().
+    T &value() { return *m_value; }
+    const T &value() const { return *m_value; }
+    T &operator*() { return *m_value; }
+    const T &operator*() const { return *m_value; }
+    T *operator->() { return &*m_value; }
+    const T *operator->() const { return &*m_value; }
+
+private:
+    std::optional<T> m_value;
+    ErrorCode m_error;
+};
+
+#endif // RESULT_H
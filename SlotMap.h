@@ -0,0 +1,124 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Generational slot map: values live in a dense array so iteration stays
+// contiguous, while callers address them through handles that stay valid
+// across unrelated inserts and erases. Erasing moves the last value into the
+// hole (O(1)) and bumps the slot's generation so stale handles are rejected.
+template <typename T>
+class SlotMap {
+public:
+    struct Handle {
+        std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t generation = 0;
+
+        bool isValid() const { return index != std::numeric_limits<std::uint32_t>::max(); }
+        bool operator==(const Handle &other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Handle &other) const { return !(*this == other); }
+    };
+
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    Handle insert(const T &value) { return emplace(value); }
+    Handle insert(T &&value) { return emplace(std::move(value)); }
+
+    template <typename... Args>
+    Handle emplace(Args &&...args) {
+        std::uint32_t slotIndex;
+        if (m_freeHead != npos) {
+            slotIndex = m_freeHead;
+            m_freeHead = m_slots[slotIndex].denseIndex;
+        } else {
+            slotIndex = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{});
+        }
+        m_dense.emplace_back(std::forward<Args>(args)...);
+        m_denseToSlot.push_back(slotIndex);
+        m_slots[slotIndex].denseIndex = static_cast<std::uint32_t>(m_dense.size() - 1);
+        return Handle{slotIndex, m_slots[slotIndex].generation};
+    }
+
+    bool erase(Handle handle) {
+        if (!contains(handle))
+            return false;
+        Slot &slot = m_slots[handle.index];
+        std::uint32_t hole = slot.denseIndex;
+        std::uint32_t last = static_cast<std::uint32_t>(m_dense.size() - 1);
+        if (hole != last) {
+            m_dense[hole] = std::move(m_dense[last]);
+            m_denseToSlot[hole] = m_denseToSlot[last];
+            m_slots[m_denseToSlot[hole]].denseIndex = hole;
+        }
+        m_dense.pop_back();
+        m_denseToSlot.pop_back();
+
+        ++slot.generation;
+        slot.denseIndex = m_freeHead;
+        m_freeHead = handle.index;
+        return true;
+    }
+
+    bool contains(Handle handle) const {
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+    }
+
+    T *get(Handle handle) { return contains(handle) ? &m_dense[m_slots[handle.index].denseIndex] : nullptr; }
+    const T *get(Handle handle) const {
+        return contains(handle) ? &m_dense[m_slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // Handle of the value currently stored at a dense position.
+    Handle handleAt(std::size_t denseIndex) const {
+        std::uint32_t slotIndex = m_denseToSlot[denseIndex];
+        return Handle{slotIndex, m_slots[slotIndex].generation};
+    }
+
+    T &operator[](std::size_t denseIndex) { return m_dense[denseIndex]; }
+    const T &operator[](std::size_t denseIndex) const { return m_dense[denseIndex]; }
+
+    std::size_t size() const { return m_dense.size(); }
+    bool empty() const { return m_dense.empty(); }
+
+    void reserve(std::size_t n) {
+        m_dense.reserve(n);
+        m_denseToSlot.reserve(n);
+        m_slots.reserve(n);
+    }
+
+    void clear() {
+        m_dense.clear();
+        m_denseToSlot.clear();
+        m_slots.clear();
+        m_freeHead = npos;
+    }
+
+    iterator begin() { return m_dense.begin(); }
+    iterator end() { return m_dense.end(); }
+    const_iterator begin() const { return m_dense.begin(); }
+    const_iterator end() const { return m_dense.end(); }
+
+private:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    // For a live slot `denseIndex` points into m_dense; for a free slot it
+    // links to the next free slot.
+    struct Slot {
+        std::uint32_t denseIndex = npos;
+        std::uint32_t generation = 0;
+    };
+
+    std::vector<T> m_dense;
+    std::vector<std::uint32_t> m_denseToSlot;
+    std::vector<Slot> m_slots;
+    std::uint32_t m_freeHead = npos;
+};
+
+#endif // SLOTMAP_H
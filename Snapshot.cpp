@@ -0,0 +1,320 @@
+#include "Snapshot.h"
+#include "Exceptions.h"
+#include "FileUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'R', 'M', 'S', 'N', 'A', 'P', '\0'};
+
+static_assert(sizeof(Snapshot::AgentRecord) == 48, "snapshot layout changed; bump kVersion");
+static_assert(sizeof(Snapshot::ClientRecord) == 48, "snapshot layout changed; bump kVersion");
+static_assert(sizeof(Snapshot::PropertyRecord) == 40, "snapshot layout changed; bump kVersion");
+static_assert(sizeof(Snapshot::ContractRecord) == 40, "snapshot layout changed; bump kVersion");
+static_assert(sizeof(Snapshot::InspectionRecord) == 32, "snapshot layout changed; bump kVersion");
+
+const std::size_t kRecordSizes[Snapshot::kTableCount] = {
+    sizeof(Snapshot::AgentRecord), sizeof(Snapshot::ClientRecord), sizeof(Snapshot::PropertyRecord),
+    sizeof(Snapshot::ContractRecord), sizeof(Snapshot::InspectionRecord)};
+
+// FNV-1a, 64-bit.
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+std::uint64_t fnv1a(const char *data, std::size_t size, std::uint64_t hash = kFnvOffset) {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t(7);
+}
+
+template <typename R>
+const R *findById(const R *records, std::size_t count, int id) {
+    const R *end = records + count;
+    const R *found = std::lower_bound(records, end, id, [](const R &record, int key) { return record.id < key; });
+    return found != end && found->id == id ? found : nullptr;
+}
+
+// Streams the file after a reserved header, keeping the checksum of what
+// was written since the last restartChecksum(); offset() is relative to
+// the end of the header.
+class SnapshotFile {
+public:
+    SnapshotFile(const std::string &path, std::size_t headerSize)
+        : m_path(path), m_file(std::fopen(path.c_str(), "wb")) {
+        if (!m_file)
+            throw FileOperationException(path, "write");
+        const std::string placeholder(headerSize, '\0');
+        if (std::fwrite(placeholder.data(), 1, headerSize, m_file) != headerSize)
+            throw FileOperationException(path, "write");
+    }
+    SnapshotFile(const SnapshotFile &) = delete;
+    SnapshotFile &operator=(const SnapshotFile &) = delete;
+    ~SnapshotFile() {
+        if (m_file) std::fclose(m_file);
+    }
+
+    std::uint64_t offset() const { return m_offset; }
+    std::uint64_t checksum() const { return m_checksum; }
+    void restartChecksum() { m_checksum = kFnvOffset; }
+
+    void write(const void *data, std::size_t size) {
+        if (std::fwrite(data, 1, size, m_file) != size)
+            throw FileOperationException(m_path, "write");
+        m_checksum = fnv1a(static_cast<const char *>(data), size, m_checksum);
+        m_offset += size;
+    }
+    void pad() {
+        static const char zeros[8] = {};
+        write(zeros, alignUp(m_offset) - m_offset);
+    }
+    // Rewrites the header in place (not covered by any checksum) and syncs.
+    void finish(const void *header, std::size_t size) {
+        if (std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(header, 1, size, m_file) != size ||
+            !syncFile(m_file))
+            throw FileOperationException(m_path, "write");
+        std::FILE *file = m_file;
+        m_file = nullptr;
+        if (std::fclose(file) != 0)
+            throw FileOperationException(m_path, "write");
+    }
+
+private:
+    std::string m_path;
+    std::FILE *m_file;
+    std::uint64_t m_offset = 0;
+    std::uint64_t m_checksum = kFnvOffset;
+};
+
+// Collects the strings of the records; equal strings are stored once.
+class StringHeap {
+public:
+    Snapshot::StringRef add(std::string_view text) {
+        std::string key(text);
+        auto found = m_offsets.find(key);
+        if (found != m_offsets.end())
+            return Snapshot::StringRef{found->second, static_cast<std::uint32_t>(text.size())};
+        if (m_bytes.size() + text.size() > UINT32_MAX)
+            throw ValidationException("Snapshot string heap exceeds 4 GB.");
+        std::uint32_t offset = static_cast<std::uint32_t>(m_bytes.size());
+        m_bytes.append(text.data(), text.size());
+        m_offsets.emplace(std::move(key), offset);
+        return Snapshot::StringRef{offset, static_cast<std::uint32_t>(text.size())};
+    }
+    const std::string &bytes() const { return m_bytes; }
+
+private:
+    std::string m_bytes;
+    std::unordered_map<std::string, std::uint32_t> m_offsets;
+};
+
+// Records of one table, sorted by id.
+template <typename T, typename R, typename Convert>
+std::vector<R> sortedRecords(const SlotMap<T> &table, Convert convert) {
+    std::vector<R> records;
+    records.reserve(table.size());
+    for (const T &value : table)
+        records.push_back(convert(value));
+    std::sort(records.begin(), records.end(), [](const R &a, const R &b) { return a.id < b.id; });
+    return records;
+}
+
+} // namespace
+
+Snapshot::Snapshot(const std::string &path) : m_file(path) {
+    if (!m_file.isOpen() || m_file.size() < sizeof(Header))
+        throw FileOperationException(path, "open snapshot");
+    std::memcpy(&m_header, m_file.data(), sizeof(Header));
+    if (std::memcmp(m_header.magic, kMagic, sizeof(kMagic)) != 0 || m_header.version != kVersion ||
+        m_header.headerSize != sizeof(Header) || m_header.fileSize != m_file.size())
+        throw FileOperationException(path, "open snapshot");
+    for (int table = 0; table < kTableCount; ++table) {
+        const Section &section = m_header.sections[table];
+        if (section.offset % 8 != 0 || section.offset < sizeof(Header) || section.offset > m_file.size() ||
+            section.count > (m_file.size() - section.offset) / kRecordSizes[table] ||
+            section.stringsOffset > m_file.size() || section.stringsSize > m_file.size() - section.stringsOffset)
+            throw FileOperationException(path, "open snapshot");
+    }
+}
+
+bool Snapshot::verify(Table table) const {
+    const Section &section = m_header.sections[table];
+    std::uint64_t hash = fnv1a(m_file.data() + section.offset, section.count * kRecordSizes[table]);
+    return fnv1a(m_file.data() + section.stringsOffset, section.stringsSize, hash) == section.checksum;
+}
+
+bool Snapshot::verify() const {
+    for (int table = 0; table < kTableCount; ++table)
+        if (!verify(static_cast<Table>(table)))
+            return false;
+    return true;
+}
+
+const Snapshot::AgentRecord *Snapshot::findAgent(int id) const {
+    return findById(agents(), count(Agents), id);
+}
+
+const Snapshot::ClientRecord *Snapshot::findClient(int id) const {
+    return findById(clients(), count(Clients), id);
+}
+
+const Snapshot::PropertyRecord *Snapshot::findProperty(int id) const {
+    return findById(properties(), count(Properties), id);
+}
+
+const Snapshot::ContractRecord *Snapshot::findContract(int id) const {
+    return findById(contracts(), count(Contracts), id);
+}
+
+const Snapshot::InspectionRecord *Snapshot::findInspection(int id) const {
+    return findById(inspections(), count(Inspections), id);
+}
+
+std::string_view Snapshot::text(Table table, StringRef ref) const {
+    const Section &section = m_header.sections[table];
+    if (ref.offset > section.stringsSize || ref.length > section.stringsSize - ref.offset)
+        return std::string_view();
+    return std::string_view(m_file.data() + section.stringsOffset + ref.offset, ref.length);
+}
+
+Agent Snapshot::toAgent(const AgentRecord &record) const {
+    Agent a;
+    a.setId(record.id);
+    a.setFirstName(std::string(text(Agents, record.firstName)));
+    a.setLastName(std::string(text(Agents, record.lastName)));
+    a.setPhone(std::string(text(Agents, record.phone)));
+    a.setEmail(std::string(text(Agents, record.email)));
+    a.setStartDate(Date::fromDays(record.startDays));
+    a.setEndDate(Date::fromDays(record.endDays));
+    return a;
+}
+
+Client Snapshot::toClient(const ClientRecord &record) const {
+    Client c;
+    c.setId(record.id);
+    c.setFirstName(std::string(text(Clients, record.firstName)));
+    c.setLastName(std::string(text(Clients, record.lastName)));
+    c.setPhone(std::string(text(Clients, record.phone)));
+    c.setEmail(std::string(text(Clients, record.email)));
+    c.setIsMarried(record.isMarried != 0);
+    c.setBudget(record.budget);
+    c.setBudgetType(static_cast<BudgetType>(record.budgetType));
+    return c;
+}
+
+Property Snapshot::toProperty(const PropertyRecord &record) const {
+    Property p;
+    p.setId(record.id);
+    p.setSizeSqm(record.sizeSqm);
+    p.setPrice(record.price);
+    p.setPropertyType(static_cast<PropertyType>(record.propertyType));
+    p.setBedrooms(record.bedrooms);
+    p.setBathrooms(record.bathrooms);
+    p.setPlaceId(PlaceDictionary::instance().intern(text(Properties, record.place)));
+    p.setAvailability(record.available != 0);
+    p.setListingType(static_cast<ListingType>(record.listingType));
+    return p;
+}
+
+Contract Snapshot::toContract(const ContractRecord &record) const {
+    Contract ct;
+    ct.setId(record.id);
+    ct.setPropertyId(record.propertyId);
+    ct.setClientId(record.clientId);
+    ct.setAgentId(record.agentId);
+    ct.setPrice(record.price);
+    ct.setStartDate(Date::fromDays(record.startDays));
+    ct.setEndDate(Date::fromDays(record.endDays));
+    ct.setContractType(static_cast<ContractType>(record.contractType));
+    ct.setIsActive(record.isActive != 0);
+    return ct;
+}
+
+Inspection Snapshot::toInspection(const InspectionRecord &record) const {
+    Inspection i;
+    i.setId(record.id);
+    i.setAgentId(record.agentId);
+    i.setPropertyId(record.propertyId);
+    i.setStartMinute(record.startMinute);
+    i.setDurationMinutes(record.durationMinutes);
+    i.setNotes(std::string(text(Inspections, record.notes)));
+    return i;
+}
+
+void Snapshot::write(const std::string &path, const SlotMap<Agent> &agents, const SlotMap<Client> &clients,
+                     const SlotMap<Property> &properties, const SlotMap<Contract> &contracts,
+                     const SlotMap<Inspection> &inspections, const SourceStamp (&sources)[kTableCount]) {
+    StringHeap heaps[kTableCount];
+    StringHeap &agentHeap = heaps[Agents], &clientHeap = heaps[Clients], &propertyHeap = heaps[Properties],
+               &inspectionHeap = heaps[Inspections];
+    std::vector<AgentRecord> agentRecords = sortedRecords<Agent, AgentRecord>(agents, [&](const Agent &a) {
+        return AgentRecord{a.getId(), a.getStartDate().toDays(), a.getEndDate().toDays(), 0,
+                           agentHeap.add(a.getFirstName()), agentHeap.add(a.getLastName()),
+                           agentHeap.add(a.getPhone()), agentHeap.add(a.getEmail())};
+    });
+    std::vector<ClientRecord> clientRecords = sortedRecords<Client, ClientRecord>(clients, [&](const Client &c) {
+        return ClientRecord{c.getId(), static_cast<std::uint8_t>(c.getIsMarried()),
+                            static_cast<std::uint8_t>(c.getBudgetTypeEnum()), 0, c.getBudget(),
+                            clientHeap.add(c.getFirstName()), clientHeap.add(c.getLastName()),
+                            clientHeap.add(c.getPhone()), clientHeap.add(c.getEmail())};
+    });
+    std::vector<PropertyRecord> propertyRecords =
+        sortedRecords<Property, PropertyRecord>(properties, [&](const Property &p) {
+            return PropertyRecord{p.getId(), p.getBedrooms(), p.getBathrooms(),
+                                  static_cast<std::uint8_t>(p.getPropertyTypeEnum()),
+                                  static_cast<std::uint8_t>(p.getListingTypeEnum()),
+                                  static_cast<std::uint8_t>(p.getAvailability()), 0,
+                                  p.getSizeSqm(), p.getPrice(), propertyHeap.add(p.getPlace())};
+        });
+    std::vector<ContractRecord> contractRecords =
+        sortedRecords<Contract, ContractRecord>(contracts, [&](const Contract &ct) {
+            return ContractRecord{ct.getId(), ct.getPropertyId(), ct.getClientId(), ct.getAgentId(),
+                                  ct.getPrice(), ct.getStartDate().toDays(), ct.getEndDate().toDays(),
+                                  static_cast<std::uint8_t>(ct.getContractTypeEnum()),
+                                  static_cast<std::uint8_t>(ct.getIsActive()), {}};
+        });
+    std::vector<InspectionRecord> inspectionRecords =
+        sortedRecords<Inspection, InspectionRecord>(inspections, [&](const Inspection &i) {
+            return InspectionRecord{i.getId(), i.getAgentId(), i.getPropertyId(), i.getStartMinute(),
+                                    i.getDurationMinutes(), 0, inspectionHeap.add(i.getNotes())};
+        });
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = sizeof(Header);
+    std::copy(std::begin(sources), std::end(sources), header.sources);
+
+    // Records stay 8-byte aligned in the file as long as the header is.
+    static_assert(sizeof(Header) % 8 == 0, "snapshot header must keep records aligned");
+    SnapshotFile out(path, sizeof(Header));
+    auto section = [&](Table table, const void *data, std::size_t count) {
+        out.pad();
+        out.restartChecksum();
+        Section &written = header.sections[table];
+        written.offset = sizeof(Header) + out.offset();
+        written.count = count;
+        out.write(data, count * kRecordSizes[table]);
+        const std::string &strings = heaps[table].bytes();
+        written.stringsOffset = sizeof(Header) + out.offset();
+        written.stringsSize = strings.size();
+        out.write(strings.data(), strings.size());
+        written.checksum = out.checksum();
+    };
+    section(Agents, agentRecords.data(), agentRecords.size());
+    section(Clients, clientRecords.data(), clientRecords.size());
+    section(Properties, propertyRecords.data(), propertyRecords.size());
+    section(Contracts, contractRecords.data(), contractRecords.size());
+    section(Inspections, inspectionRecords.data(), inspectionRecords.size());
+    header.fileSize = sizeof(Header) + out.offset();
+    out.finish(&header, sizeof(Header));
+}
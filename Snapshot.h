@@ -0,0 +1,161 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Agent.h"
+#include "Client.h"
+#include "Property.h"
+#include "Contract.h"
+#include "Inspection.h"
+#include "MappedFile.h"
+#include "SlotMap.h"
+
+// Versioned binary image of every table. Layout (little-endian):
+//   Header | agents: records, strings | clients: records, strings | ...
+// Records are fixed-width, 8-byte aligned and sorted by id; their strings
+// are (offset, length) references into their own table's string heap.
+// Each table has its own checksum, so one table can be verified and read
+// without touching the others. Opening a snapshot maps it and checks the
+// header only, so it costs the same for any size. Records are read in
+// place from the mapped pages: find* binary-searches a table by id, and
+// loading a table copies its records into entities.
+class Snapshot {
+public:
+    static constexpr std::uint32_t kVersion = 2;
+
+    struct StringRef {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    struct AgentRecord {
+        std::int32_t id;
+        std::int32_t startDays; // Date::toDays()
+        std::int32_t endDays;
+        std::uint32_t reserved;
+        StringRef firstName, lastName, phone, email;
+    };
+
+    struct ClientRecord {
+        std::int32_t id;
+        std::uint8_t isMarried;
+        std::uint8_t budgetType; // BudgetType
+        std::uint16_t reserved;
+        double budget;
+        StringRef firstName, lastName, phone, email;
+    };
+
+    struct PropertyRecord {
+        std::int32_t id;
+        std::int32_t bedrooms;
+        std::int32_t bathrooms;
+        std::uint8_t propertyType; // PropertyType
+        std::uint8_t listingType;  // ListingType
+        std::uint8_t available;
+        std::uint8_t reserved;
+        double sizeSqm;
+        double price;
+        StringRef place;
+    };
+
+    struct ContractRecord {
+        std::int32_t id;
+        std::int32_t propertyId;
+        std::int32_t clientId;
+        std::int32_t agentId;
+        double price;
+        std::int32_t startDays;
+        std::int32_t endDays;
+        std::uint8_t contractType; // ContractType
+        std::uint8_t isActive;
+        std::uint8_t reserved[6];
+    };
+
+    struct InspectionRecord {
+        std::int32_t id;
+        std::int32_t agentId;
+        std::int32_t propertyId;
+        std::int32_t startMinute;
+        std::int32_t durationMinutes;
+        std::uint32_t reserved;
+        StringRef notes;
+    };
+
+    // Source files the snapshot was taken alongside: their size and
+    // modification time when it was written.
+    struct SourceStamp {
+        std::uint64_t size;
+        std::int64_t modified;
+    };
+    enum Table { Agents, Clients, Properties, Contracts, Inspections, kTableCount };
+
+    // Maps `path` and validates the header and section bounds; throws
+    // FileOperationException if it is missing, truncated or of another
+    // version. Checksums are only checked by verify().
+    explicit Snapshot(const std::string &path);
+
+    bool verify(Table table) const; // checksum of the table's records and strings
+    bool verify() const;            // every table
+
+    // Record arrays, sorted by id and valid while the Snapshot lives.
+    const AgentRecord *agents() const { return records<AgentRecord>(Agents); }
+    const ClientRecord *clients() const { return records<ClientRecord>(Clients); }
+    const PropertyRecord *properties() const { return records<PropertyRecord>(Properties); }
+    const ContractRecord *contracts() const { return records<ContractRecord>(Contracts); }
+    const InspectionRecord *inspections() const { return records<InspectionRecord>(Inspections); }
+    std::size_t count(Table table) const { return m_header.sections[table].count; }
+
+    // Binary search by id, in place; nullptr if absent.
+    const AgentRecord *findAgent(int id) const;
+    const ClientRecord *findClient(int id) const;
+    const PropertyRecord *findProperty(int id) const;
+    const ContractRecord *findContract(int id) const;
+    const InspectionRecord *findInspection(int id) const;
+
+    // Text of a string reference of `table`'s records; empty if it points
+    // outside that table's heap.
+    std::string_view text(Table table, StringRef ref) const;
+    const SourceStamp &source(Table table) const { return m_header.sources[table]; }
+
+    // Materialize a record as an entity.
+    Agent toAgent(const AgentRecord &record) const;
+    Client toClient(const ClientRecord &record) const;
+    Property toProperty(const PropertyRecord &record) const;
+    Contract toContract(const ContractRecord &record) const;
+    Inspection toInspection(const InspectionRecord &record) const;
+
+    // Writes a snapshot of the given tables to `path` (which is replaced),
+    // fsyncing it before returning. Throws FileOperationException.
+    static void write(const std::string &path, const SlotMap<Agent> &agents, const SlotMap<Client> &clients,
+                      const SlotMap<Property> &properties, const SlotMap<Contract> &contracts,
+                      const SlotMap<Inspection> &inspections, const SourceStamp (&sources)[kTableCount]);
+
+private:
+    struct Section {
+        std::uint64_t offset; // records
+        std::uint64_t count;
+        std::uint64_t stringsOffset;
+        std::uint64_t stringsSize;
+        std::uint64_t checksum; // records and strings
+    };
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t fileSize;
+        Section sections[kTableCount];
+        SourceStamp sources[kTableCount];
+    };
+
+    template <typename R>
+    const R *records(Table table) const {
+        return reinterpret_cast<const R *>(m_file.data() + m_header.sections[table].offset);
+    }
+
+    MappedFile m_file;
+    Header m_header;
+};
+
+#endif // SNAPSHOT_H
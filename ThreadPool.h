@@ -0,0 +1,83 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size worker pool. Tasks run in FIFO order; exceptions thrown by a
+// task are delivered through its future.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threads = 0); // 0 = one per hardware thread
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    std::size_t size() const { return m_workers.size(); }
+
+    template <typename Fn>
+    auto submit(Fn fn) -> std::future<typename std::invoke_result<Fn>::type> {
+        using Result = typename std::invoke_result<Fn>::type;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+        std::future<Result> result = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return result;
+    }
+
+    // Calls fn(begin, end) for consecutive chunks of [0, n) and blocks until
+    // all of them finished. The calling thread helps with queued work while
+    // it waits, so this is safe to call from inside a pool task.
+    template <typename Fn>
+    void parallelFor(std::size_t n, std::size_t chunk, Fn fn) {
+        if (n == 0) return;
+        if (chunk == 0) chunk = 1;
+        std::vector<std::future<void>> pending;
+        pending.reserve((n + chunk - 1) / chunk);
+        for (std::size_t begin = 0; begin < n; begin += chunk) {
+            std::size_t end = begin + chunk < n ? begin + chunk : n;
+            pending.push_back(submit([&fn, begin, end]() { fn(begin, end); }));
+        }
+        for (auto &f : pending) {
+            wait(f);
+        }
+        for (auto &f : pending) {
+            f.get();
+        }
+    }
+
+    // Waits for a future, running queued tasks on this thread in the meantime.
+    template <typename T>
+    void wait(std::future<T> &future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // Once the queue is empty, whatever we wait on is already running
+            // on another thread and a plain blocking wait cannot deadlock.
+            if (!runPendingTask()) {
+                future.wait();
+                return;
+            }
+        }
+    }
+
+private:
+    void enqueue(std::function<void()> task);
+    bool runPendingTask();
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    bool m_stopping = false;
+};
+
+#endif // THREADPOOL_H
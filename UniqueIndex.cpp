@@ -0,0 +1,95 @@
+#include "UniqueIndex.h"
+#include <cctype>
+
+UniqueIndex::UniqueIndex(Normalizer normalize) : m_normalize(normalize) {}
+
+int UniqueIndex::find(std::string_view value) const {
+    std::string key = m_normalize(value);
+    if(key.empty()) return -1;
+    auto found = m_owners.find(key);
+    return found != m_owners.end() ? found->second : -1;
+}
+
+bool UniqueIndex::isAvailable(std::string_view value, int id) const {
+    int owner = find(value);
+    return owner == -1 || owner == id;
+}
+
+bool UniqueIndex::canReplace(std::string_view from, std::string_view to, int id) const {
+    return m_normalize(from) == m_normalize(to) || isAvailable(to, id);
+}
+
+bool UniqueIndex::claim(std::string_view value, int id) {
+    std::string key = m_normalize(value);
+    if(key.empty()) return true;
+    auto inserted = m_owners.emplace(key, id);
+    if(inserted.second || inserted.first->second == id)
+        return true;
+    m_holders.emplace(std::move(key), id);
+    return false;
+}
+
+void UniqueIndex::release(std::string_view value, int id) {
+    std::string key = m_normalize(value);
+    auto found = m_owners.find(key);
+    if(found == m_owners.end())
+        return;
+    auto holders = m_holders.equal_range(key);
+    if(found->second != id) {
+        for(auto h = holders.first; h != holders.second; ++h) {
+            if(h->second == id) {
+                m_holders.erase(h);
+                break;
+            }
+        }
+        return;
+    }
+    if(holders.first == holders.second) {
+        m_owners.erase(found);
+        return;
+    }
+    auto next = holders.first;
+    for(auto h = holders.first; h != holders.second; ++h) {
+        if(h->second < next->second) next = h;
+    }
+    found->second = next->second;
+    m_holders.erase(next);
+}
+
+void UniqueIndex::replace(std::string_view from, std::string_view to, int id) {
+    if(m_normalize(from) == m_normalize(to))
+        return;
+    release(from, id);
+    claim(to, id);
+}
+
+void UniqueIndex::clear() {
+    m_owners.clear();
+    m_holders.clear();
+}
+
+void UniqueIndex::reserve(std::size_t n) {
+    m_owners.reserve(n);
+}
+
+std::string UniqueIndex::normalizeEmail(std::string_view email) {
+    std::size_t first = 0;
+    std::size_t last = email.size();
+    while(first < last && std::isspace(static_cast<unsigned char>(email[first]))) ++first;
+    while(last > first && std::isspace(static_cast<unsigned char>(email[last - 1]))) --last;
+    std::string key;
+    key.reserve(last - first);
+    for(std::size_t i = first; i < last; ++i) {
+        key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(email[i]))));
+    }
+    return key;
+}
+
+std::string UniqueIndex::normalizePhone(std::string_view phone) {
+    std::string key;
+    key.reserve(phone.size());
+    for(char c : phone) {
+        if(std::isdigit(static_cast<unsigned char>(c))) key.push_back(c);
+    }
+    return key;
+}
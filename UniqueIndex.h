@@ -0,0 +1,48 @@
+#ifndef UNIQUEINDEX_H
+#define UNIQUEINDEX_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Hash index enforcing that a normalized value (an email, a phone number)
+// belongs to at most one entity id. Values that normalize to an empty
+// string are never indexed. Rows loaded from disk may predate the rule:
+// claim() then records the extra ids as holders of a value someone else
+// owns, and the first remaining holder takes it over once the owner
+// releases it.
+class UniqueIndex {
+public:
+    using Normalizer = std::string (*)(std::string_view);
+
+    explicit UniqueIndex(Normalizer normalize);
+
+    // Id owning the value, or -1.
+    int find(std::string_view value) const;
+    // True unless the value is already owned by an id other than `id`.
+    bool isAvailable(std::string_view value, int id) const;
+    // True if `id` may change its value from `from` to `to`: either both
+    // normalize to the same key or `to` is available.
+    bool canReplace(std::string_view from, std::string_view to, int id) const;
+    // Assigns the value to `id`; returns false if another id owns it, in
+    // which case `id` is recorded as a further holder.
+    bool claim(std::string_view value, int id);
+    // Drops `id`'s hold on the value; an owner hands it to the lowest
+    // remaining holder id.
+    void release(std::string_view value, int id);
+    // release(from) then claim(to), or nothing if both are the same key.
+    void replace(std::string_view from, std::string_view to, int id);
+    void clear();
+    void reserve(std::size_t n);
+
+    static std::string normalizeEmail(std::string_view email); // trimmed, lowercased
+    static std::string normalizePhone(std::string_view phone); // digits only
+
+private:
+    Normalizer m_normalize;
+    std::unordered_map<std::string, int> m_owners;
+    std::unordered_multimap<std::string, int> m_holders; // duplicates, besides the owner
+};
+
+#endif // UNIQUEINDEX_H
@@ -0,0 +1,48 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+// Helpers shared by the programs in bench/. They are not part of the
+// application build; each program lists its own g++ command at the top.
+
+// Wall-clock seconds since construction.
+class Stopwatch {
+public:
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+};
+
+// Makes an empty temporary directory the working directory while it lives,
+// so the CSV, journal and snapshot files CRMSystem writes never touch real
+// data. The directory is removed again on destruction.
+class ScratchDir {
+public:
+    explicit ScratchDir(const std::string &name)
+        : m_previous(std::filesystem::current_path()),
+          m_path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(m_path);
+        std::filesystem::create_directories(m_path);
+        std::filesystem::current_path(m_path);
+    }
+    ~ScratchDir() {
+        std::error_code error;
+        std::filesystem::current_path(m_previous, error);
+        std::filesystem::remove_all(m_path, error);
+    }
+    ScratchDir(const ScratchDir &) = delete;
+    ScratchDir &operator=(const ScratchDir &) = delete;
+
+private:
+    std::filesystem::path m_previous;
+    std::filesystem::path m_path;
+};
+
+#endif // BENCHUTIL_H
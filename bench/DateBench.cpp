@@ -0,0 +1,69 @@
+// Date::tryParse and Date::format throughput over random dates, plus a
+// round trip of every valid day in both accepted input formats.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -I. bench/DateBench.cpp Date.cpp -o date_bench
+//   ./date_bench [dates]                (default 1000000)
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "Date.h"
+#include "bench/BenchUtil.h"
+
+// Parses `text` and checks it gives back `day`.
+static bool roundTrips(const std::string &text, const Date &day) {
+    std::optional<Date> parsed = Date::tryParse(text);
+    return parsed && *parsed == day;
+}
+
+int main(int argc, char **argv) {
+    const long long count = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    if (count <= 0) {
+        std::fprintf(stderr, "usage: %s [dates]\n", argv[0]);
+        return 1;
+    }
+
+    const std::int32_t first = Date::daysFromCivil(1900, 1, 1);
+    const std::int32_t last = Date::daysFromCivil(2100, 12, 31);
+    std::mt19937 random(42);
+    std::uniform_int_distribution<std::int32_t> anyDay(first, last);
+    std::vector<Date> dates;
+    std::vector<std::string> texts;
+    dates.reserve(count);
+    texts.reserve(count);
+    for (long long i = 0; i < count; ++i) {
+        dates.push_back(Date::fromDays(anyDay(random)));
+        texts.push_back(dates.back().toString());
+    }
+
+    long long checksum = 0;
+    Stopwatch parsing;
+    for (const std::string &text : texts)
+        checksum += Date::tryParse(text)->toDays();
+    double parseSeconds = parsing.seconds();
+
+    char buffer[Date::kFormattedSize];
+    Stopwatch formatting;
+    for (const Date &date : dates)
+        checksum += static_cast<long long>(date.format(buffer)) + buffer[9];
+    double formatSeconds = formatting.seconds();
+
+    std::printf("parse:  %6.1f M dates/s\n", count / parseSeconds / 1e6);
+    std::printf("format: %6.1f M dates/s  (checksum %lld)\n", count / formatSeconds / 1e6, checksum);
+
+    // Every day from 1900-01-01 to 2100-12-31 as "YYYY-MM-DD" and "YYYYMMDD".
+    long long failures = 0;
+    for (std::int32_t days = first; days <= last; ++days) {
+        Date day = Date::fromDays(days);
+        std::string dashed = day.toString();
+        std::string compact = dashed.substr(0, 4) + dashed.substr(5, 2) + dashed.substr(8, 2);
+        if (!roundTrips(dashed, day) || !roundTrips(compact, day)) {
+            if (failures++ < 10)
+                std::printf("round trip failed: %s\n", dashed.c_str());
+        }
+    }
+    std::printf("round trip of %d days: %s\n", last - first + 1, failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
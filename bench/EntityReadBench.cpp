@@ -0,0 +1,103 @@
+// Heap allocations made while reading every field of stored agents and
+// clients: in place through getXById, and through the searchXById copies
+// the menus used before.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. bench/EntityReadBench.cpp $(ls *.cpp | grep -v -e main.cpp -e DatabaseManager.cpp) -o entity_read_bench
+//   ./entity_read_bench [records]       (default 1000 of each)
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "CRMSystem.h"
+#include "bench/BenchUtil.h"
+
+static std::atomic<std::size_t> allocations{0};
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// Touches every field so the reads cannot be optimized away.
+static std::size_t readAgent(const Agent &a) {
+    return a.getId() + a.getFirstName().size() + a.getLastName().size() + a.getPhone().size() +
+           a.getEmail().size() + a.getStartDate().toDays() + a.getEndDate().isEmpty();
+}
+
+static std::size_t readClient(const Client &c) {
+    return c.getId() + c.getFirstName().size() + c.getLastName().size() + c.getPhone().size() +
+           c.getEmail().size() + c.getIsMarried() + static_cast<std::size_t>(c.getBudget()) +
+           c.getBudgetType().size();
+}
+
+template <typename Read>
+static std::size_t countAllocations(Read read, std::size_t &checksum) {
+    std::size_t before = allocations.load();
+    checksum += read();
+    return allocations.load() - before;
+}
+
+int main(int argc, char **argv) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 1000;
+    if (count <= 0) {
+        std::fprintf(stderr, "usage: %s [records]\n", argv[0]);
+        return 1;
+    }
+
+    ScratchDir scratch("crm-entity-read-bench");
+    CRMSystem system(Journal::SyncPolicy::Never);
+    // Names and emails longer than the small-string buffer, as real ones
+    // mostly are, so every copied string allocates.
+    for (int i = 0; i < count; ++i) {
+        std::string n = std::to_string(i);
+        system.addAgent(Agent(-1, "Agentfirstname" + n, "Agentlastname" + n, std::to_string(10000000 + i),
+                              "agent" + n + "@example-agency.com", "2020-01-01", ""));
+        system.addClient(Client(-1, "Clientfirstname" + n, "Clientlastname" + n, std::to_string(20000000 + i),
+                                "client" + n + "@example-mail.com", i % 2 == 0, 250000.0, "buy"));
+    }
+
+    std::size_t checksum = 0;
+    std::size_t agentsInPlace = countAllocations([&] {
+        std::size_t sum = 0;
+        for (int id = 1; id <= count; ++id)
+            sum += readAgent(system.getAgentById(id));
+        return sum;
+    }, checksum);
+    std::size_t agentsCopied = countAllocations([&] {
+        std::size_t sum = 0;
+        for (int id = 1; id <= count; ++id)
+            sum += readAgent(system.searchAgentById(id));
+        return sum;
+    }, checksum);
+    std::size_t clientsInPlace = countAllocations([&] {
+        std::size_t sum = 0;
+        for (int id = 1; id <= count; ++id)
+            sum += readClient(system.getClientById(id));
+        return sum;
+    }, checksum);
+    std::size_t clientsCopied = countAllocations([&] {
+        std::size_t sum = 0;
+        for (int id = 1; id <= count; ++id)
+            sum += readClient(system.searchClientById(id));
+        return sum;
+    }, checksum);
+
+    std::printf("%d agents:  %zu allocations in place, %zu through searchAgentById\n", count, agentsInPlace,
+                agentsCopied);
+    std::printf("%d clients: %zu allocations in place, %zu through searchClientById\n", count, clientsInPlace,
+                clientsCopied);
+    std::printf("(checksum %zu)\n", checksum);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Top-K client-to-property matching: ranks every client against a synthetic
+// listing set on the worker pool, timed including pool construction.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. bench/MatchmakerBench.cpp Matchmaker.cpp ThreadPool.cpp -o matchmaker_bench
+//   ./matchmaker_bench [clients] [listings]   (default 100000 and 1000000)
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "Matchmaker.h"
+#include "ThreadPool.h"
+#include "bench/BenchUtil.h"
+
+int main(int argc, char **argv) {
+    const long long clients = argc > 1 ? std::atoll(argv[1]) : 100000;
+    const long long listings = argc > 2 ? std::atoll(argv[2]) : 1000000;
+    if (clients <= 0 || listings <= 0) {
+        std::fprintf(stderr, "usage: %s [clients] [listings]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::uniform_real_distribution<double> salePrice(50000.0, 2000000.0);
+    std::uniform_real_distribution<double> rentPrice(300.0, 8000.0);
+    std::uniform_real_distribution<double> anySize(30.0, 400.0);
+
+    std::vector<Matchmaker::Listing> listed;
+    listed.reserve(listings);
+    for (long long i = 0; i < listings; ++i) {
+        bool sale = coin(random);
+        listed.push_back({static_cast<int>(i + 1), sale ? Matchmaker::Market::Sale : Matchmaker::Market::Rent,
+                          sale ? salePrice(random) : rentPrice(random), anySize(random)});
+    }
+    std::vector<Matchmaker::Request> requests;
+    requests.reserve(clients);
+    for (long long i = 0; i < clients; ++i) {
+        bool sale = coin(random);
+        requests.push_back({static_cast<int>(i + 1), sale ? Matchmaker::Market::Sale : Matchmaker::Market::Rent,
+                            sale ? salePrice(random) : rentPrice(random)});
+    }
+
+    MatchOptions options;
+    Stopwatch building;
+    Matchmaker matchmaker(listed, options);
+    double buildSeconds = building.seconds();
+
+    Stopwatch matching;
+    ThreadPool pool;
+    std::vector<ClientMatches> results = matchmaker.matchAll(requests, pool);
+    double matchSeconds = matching.seconds();
+
+    std::size_t matches = 0;
+    for (const ClientMatches &result : results)
+        matches += result.matches.size();
+    std::printf("indexed %lld listings in %.3f s\n", listings, buildSeconds);
+    std::printf("matched %lld clients (top %zu) in %.3f s on %zu threads, %.1f matches per client\n", clients,
+                options.topK, matchSeconds, pool.size(), static_cast<double>(matches) / clients);
+    return 0;
+}
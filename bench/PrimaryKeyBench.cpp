@@ -0,0 +1,67 @@
+// Point lookups by id through CRMSystem's primary-key index, against the
+// linear scan over the table that the index replaced.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. bench/PrimaryKeyBench.cpp $(ls *.cpp | grep -v -e main.cpp -e DatabaseManager.cpp) -o primary_key_bench
+//   ./primary_key_bench [agents]        (default 200000)
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "CRMSystem.h"
+#include "bench/BenchUtil.h"
+
+int main(int argc, char **argv) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int lookups = 1000000;
+    const int scans = 2000;
+    if (count <= 0) {
+        std::fprintf(stderr, "usage: %s [agents]\n", argv[0]);
+        return 1;
+    }
+
+    ScratchDir scratch("crm-primary-key-bench");
+    CRMSystem system(Journal::SyncPolicy::Never);
+
+    Stopwatch adding;
+    for (int i = 0; i < count; ++i) {
+        std::string n = std::to_string(i);
+        system.addAgent(Agent(-1, "Agent", "No" + n, std::to_string(10000000 + i), "agent" + n + "@example.com",
+                              "2020-01-01", ""));
+    }
+    std::printf("added %d agents in %.3f s\n", count, adding.seconds());
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> anyId(1, count);
+    std::vector<int> ids(lookups);
+    for (int &id : ids)
+        id = anyId(random);
+
+    long long checksum = 0;
+    Stopwatch indexed;
+    for (int id : ids)
+        checksum += system.findAgent(id)->getId();
+    double indexedSeconds = indexed.seconds();
+
+    // The table as it was before the index: a vector searched front to back.
+    std::vector<Agent> table;
+    table.reserve(count);
+    for (int id = 1; id <= count; ++id)
+        table.push_back(system.getAgentById(id));
+    Stopwatch scanned;
+    for (int i = 0; i < scans; ++i) {
+        int id = ids[i];
+        auto found = std::find_if(table.begin(), table.end(), [id](const Agent &a) { return a.getId() == id; });
+        checksum += found->getId();
+    }
+    double scannedSeconds = scanned.seconds();
+
+    double indexedNs = indexedSeconds * 1e9 / lookups;
+    double scannedNs = scannedSeconds * 1e9 / scans;
+    std::printf("index lookup: %.1f ns (%d lookups)\n", indexedNs, lookups);
+    std::printf("linear scan:  %.1f ns (%d lookups)\n", scannedNs, scans);
+    std::printf("speedup:      %.0fx (checksum %lld)\n", scannedNs / indexedNs, checksum);
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Throughput of the property predicate kernels on synthetic columns, for
+// every instruction set this CPU supports, checking that they all select
+// the same rows.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -I. bench/PropertyKernelsBench.cpp PropertyKernels.cpp -o property_kernels_bench
+//   ./property_kernels_bench [rows]     (default 10000000)
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "PropertyKernels.h"
+#include "bench/BenchUtil.h"
+
+int main(int argc, char **argv) {
+    const long long rows = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    const int repeats = 5;
+    if (rows <= 0) {
+        std::fprintf(stderr, "usage: %s [rows]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<double> price(rows), size(rows);
+    std::vector<std::int32_t> bedrooms(rows);
+    std::vector<std::uint8_t> available(rows), listing(rows);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> anyPrice(50000.0, 2000000.0);
+    std::uniform_real_distribution<double> anySize(30.0, 400.0);
+    std::uniform_int_distribution<int> anyBedrooms(0, 6);
+    std::uniform_int_distribution<int> coin(0, 1);
+    for (long long i = 0; i < rows; ++i) {
+        price[i] = anyPrice(random);
+        size[i] = anySize(random);
+        bedrooms[i] = anyBedrooms(random);
+        available[i] = static_cast<std::uint8_t>(coin(random));
+        listing[i] = static_cast<std::uint8_t>(coin(random));
+    }
+
+    PropertyColumnView columns;
+    columns.rows = static_cast<std::size_t>(rows);
+    columns.price = price.data();
+    columns.sizeSqm = size.data();
+    columns.bedrooms = bedrooms.data();
+    columns.available = available.data();
+    columns.listingCode = listing.data();
+
+    // price range, size >= S, bedrooms >= N, available, listing type
+    PropertyPredicate predicate;
+    predicate.usePrice = true;
+    predicate.minPrice = 200000.0;
+    predicate.maxPrice = 900000.0;
+    predicate.useSize = true;
+    predicate.minSize = 80.0;
+    predicate.useBedrooms = true;
+    predicate.minBedrooms = 2;
+    predicate.useAvailable = true;
+    predicate.useListing = true;
+    predicate.listingCode = 1;
+
+    using PropertyKernels::Isa;
+    const Isa isas[] = {Isa::Scalar, Isa::SSE2, Isa::AVX2};
+    PropertyKernels::Bitmap reference;
+    bool identical = true;
+    for (Isa isa : isas) {
+        if (static_cast<int>(isa) > static_cast<int>(PropertyKernels::bestIsa()))
+            break;
+        double best = 0.0;
+        PropertyKernels::Bitmap bitmap;
+        for (int r = 0; r < repeats; ++r) {
+            Stopwatch timer;
+            bitmap = PropertyKernels::evaluate(columns, predicate, isa);
+            double seconds = timer.seconds();
+            if (r == 0 || seconds < best)
+                best = seconds;
+        }
+        if (reference.empty())
+            reference = bitmap;
+        else if (bitmap != reference)
+            identical = false;
+        std::printf("%-6s %8.1f M rows/s  (%zu selected, best of %d)\n", PropertyKernels::isaName(isa),
+                    rows / best / 1e6, PropertyKernels::countSelected(bitmap), repeats);
+    }
+    std::printf("bitmaps %s\n", identical ? "identical" : "DIFFER");
+    return identical ? 0 : 1;
+}
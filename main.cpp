@@ -5,6 +5,7 @@
 #include <cctype>  // for isdigit()
 #include <sstream>
 #include <algorithm> // for transform
+#include <cstdlib>   // for getenv
 #include "CRMSystem.h"
 #include "Agent.h"
 #include "Client.h"
@@ -305,7 +306,11 @@ int main() {
         db.execute("CREATE TABLE IF NOT EXISTS Properties (ID INTEGER PRIMARY KEY AUTOINCREMENT, SizeSqm REAL, Price REAL, Type TEXT, Bedrooms INTEGER, Bathrooms INTEGER, Place TEXT, Available INTEGER, ListingType TEXT);");
         db.execute("CREATE TABLE IF NOT EXISTS Contracts (ID INTEGER PRIMARY KEY AUTOINCREMENT, PropertyId INTEGER, ClientId INTEGER, AgentId INTEGER, Price REAL, StartDate TEXT, EndDate TEXT, ContractType TEXT, IsActive INTEGER);");
     int mainChoice = 0;
+    // Tables load on first use; CRM_PREFETCH warms the rest in the
+    // background while the user reads the first menu.
+    bool prefetch = std::getenv("CRM_PREFETCH") != nullptr;
 
+    // Changes are journaled as they happen; the CSV files are written back on exit.
     while (true) {
         cout << "\n=== Real Estate CRM System ===\n"
              << "1. Manage Agents\n"
@@ -314,7 +319,11 @@ int main() {
              << "4. Manage Contracts\n"
              << "5. Create New Contract\n"
              << "6. Exit\n"
-             << "Enter choice: ";
+             << "Enter choice: " << std::flush;
+        if (prefetch) {
+            system.prefetchTables();
+            prefetch = false;
+        }
         cin >> mainChoice;
         if (cin.fail()) {
             cin.clear();
@@ -403,18 +412,23 @@ int main() {
                 }
                 else if (choice == 2) {
                     int id = getValidInputNumber<int>("Enter agent ID to remove: ");
-                    if (system.removeAgent(id)){
-                        stringstream deleteQuery;
-                        deleteQuery << "DELETE FROM Agents WHERE ID = " << id << ";";
-                        db.execute(deleteQuery.str());
-                        cout << "Agent removed successfully.\n";
-                    }else
-                        cout << "Agent not found.\n";
+                    try {
+                        if (system.removeAgent(id)){
+                            stringstream deleteQuery;
+                            deleteQuery << "DELETE FROM Agents WHERE ID = " << id << ";";
+                            db.execute(deleteQuery.str());
+                            cout << "Agent removed successfully.\n";
+                        }else
+                            cout << "Agent not found.\n";
+                    }
+                    catch (const ValidationException& e) {
+                        cerr << "Validation Error: " << e.what() << "\n";
+                    }
                 }
                 else if (choice == 3) {
                     int id = getValidInputNumber<int>("Enter agent ID to search: ");
                     try {
-                        Agent a = system.searchAgentById(id);
+                        const Agent &a = system.getAgentById(id);
                         cout << "Found: " << a << "\n";
                     }
                     catch (const AgentNotFoundException& e) {
@@ -586,18 +600,23 @@ int main() {
                 }
                 else if (choice == 2) {
                     int id = getValidInputNumber<int>("Enter client ID to remove: ");
-                    if (system.removeClient(id)){
-                        std::stringstream query;
-                        query << "DELETE FROM Clients WHERE ID = " << id << ";";
-                        db.execute(query.str());
-                        cout << "Client removed successfully.\n";
-                    }else
-                        cout << "Client not found.\n";
+                    try {
+                        if (system.removeClient(id)){
+                            std::stringstream query;
+                            query << "DELETE FROM Clients WHERE ID = " << id << ";";
+                            db.execute(query.str());
+                            cout << "Client removed successfully.\n";
+                        }else
+                            cout << "Client not found.\n";
+                    }
+                    catch (const ValidationException& e) {
+                        cerr << "Validation Error: " << e.what() << "\n";
+                    }
                 }
                 else if (choice == 3) {
                     int id = getValidInputNumber<int>("Enter client ID to search: ");
                     try {
-                        Client c = system.searchClientById(id);
+                        const Client &c = system.getClientById(id);
                         cout << "Found: " << c << "\n";
                     }
                     catch (const ClientNotFoundException& e) {
@@ -805,18 +824,23 @@ int main() {
                 }
                 else if (choice == 2) {
                     int id = getValidInputNumber<int>("Enter property ID to remove: ");
-                    if (system.removeProperty(id)){
-                        std::stringstream query;
-                        query << "DELETE FROM Properties WHERE ID = " << id << ";";
-                        db.execute(query.str());
-                        cout << "Property removed successfully.\n";
-                    }else
-                        cout << "Property not found.\n";
+                    try {
+                        if (system.removeProperty(id)){
+                            std::stringstream query;
+                            query << "DELETE FROM Properties WHERE ID = " << id << ";";
+                            db.execute(query.str());
+                            cout << "Property removed successfully.\n";
+                        }else
+                            cout << "Property not found.\n";
+                    }
+                    catch (const ValidationException& e) {
+                        cerr << "Validation Error: " << e.what() << "\n";
+                    }
                 }
                 else if (choice == 3) {
                     int id = getValidInputNumber<int>("Enter property ID to search: ");
                     try {
-                        Property p = system.searchPropertyById(id);
+                        const Property &p = system.getPropertyById(id);
                         cout << "Found: " << p << "\n";
                     }
                     catch (const PropertyNotFoundException& e) {
@@ -1042,7 +1066,7 @@ int main() {
                 else if (choice == 3) {
                     int id = getValidInputNumber<int>("Enter contract ID to search: ");
                     try {
-                        Contract c = system.searchContractById(id);
+                        const Contract &c = system.getContractById(id);
                         cout << "Found: " << c << "\n";
                     }
                     catch (const ContractNotFoundException& e) {
@@ -1196,6 +1220,17 @@ int main() {
             }
         }
         else if (mainChoice == 6) {
+            // Writes back the session's changes (saveBinarySnapshot flushes
+            // first), then lets the next start skip parsing the CSV files
+            try {
+                system.saveBinarySnapshot();
+            } catch (const CRMException& e) {
+                cerr << "Error saving data: " << e.what() << endl;
+            }
+            if (std::getenv("CRM_LOAD_TIMINGS")) {
+                for (const auto& load : system.getLoadTimes())
+                    cerr << "Loaded " << load.rows << " " << load.table << " in " << load.milliseconds << " ms\n";
+            }
             cout << "Exiting. Goodbye!\n";
             break;
         }